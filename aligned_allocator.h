@@ -0,0 +1,216 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_ALIGNED_ALLOCATOR_H_
+#define OOP_ASSIGNMENTS_VECTOR_ALIGNED_ALLOCATOR_H_
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "vector.h"
+
+// Allocator that aligns every block to Alignment bytes, 64 by default, so that SIMD kernels
+// over Vector::Data() need no unaligned head.
+template <typename T, size_t Alignment = 64>
+class AlignedAllocator {
+  static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+  static_assert(Alignment >= alignof(T), "Alignment may not be weaker than alignof(T)");
+
+ public:
+  using value_type = T;  // NOLINT
+  using is_always_equal = std::true_type;  // NOLINT
+  using propagate_on_container_move_assignment = std::true_type;  // NOLINT
+
+  template <typename U>
+  struct rebind {  // NOLINT
+    using other = AlignedAllocator<U, std::max(Alignment, alignof(U))>;  // NOLINT
+  };
+
+  static constexpr size_t kAlignment = Alignment;
+
+  AlignedAllocator() noexcept = default;
+  template <typename U, size_t OtherAlignment>
+  AlignedAllocator(const AlignedAllocator<U, OtherAlignment>& /*other*/) noexcept {  // NOLINT
+  }
+
+  [[nodiscard]] T* allocate(size_t count) {  // NOLINT
+    if (count > static_cast<size_t>(-1) / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+  }
+
+  void deallocate(T* ptr, size_t count) noexcept {  // NOLINT
+    ::operator delete(ptr, count * sizeof(T), std::align_val_t(Alignment));
+  }
+};
+
+template <typename T, size_t A, typename U, size_t B>
+[[nodiscard]] bool operator==(const AlignedAllocator<T, A>& /*lhs*/, const AlignedAllocator<U, B>& /*rhs*/) noexcept {
+  return true;
+}
+
+template <typename T, size_t A, typename U, size_t B>
+[[nodiscard]] bool operator!=(const AlignedAllocator<T, A>& /*lhs*/, const AlignedAllocator<U, B>& /*rhs*/) noexcept {
+  return false;
+}
+
+template <typename T, size_t Alignment>
+struct AllowsTrivialRelocation<AlignedAllocator<T, Alignment>> : std::true_type {};
+
+// Aligned allocator whose blocks of at least Threshold bytes are mapped directly at a 2 MiB
+// boundary and rounded up to whole 2 MiB pages, so that the kernel can back them with huge
+// pages and a scan over a large Vector takes far fewer TLB misses. By default such blocks are
+// marked with madvise(MADV_HUGEPAGE) and rely on transparent huge pages; with UseHugeTlb they
+// first try MAP_HUGETLB from the reserved pool and fall back to that if it is exhausted.
+// Mapped blocks grow through the reallocate hook with mremap, without copying. Elsewhere
+// than Linux every block comes from the aligned operator new.
+template <typename T, size_t Threshold = (size_t{2} << 20), size_t Alignment = 64, bool UseHugeTlb = false>
+class HugePageAllocator {
+  static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+  static_assert(Alignment >= alignof(T), "Alignment may not be weaker than alignof(T)");
+
+ public:
+  using value_type = T;  // NOLINT
+  using is_always_equal = std::true_type;  // NOLINT
+  using propagate_on_container_move_assignment = std::true_type;  // NOLINT
+
+  template <typename U>
+  struct rebind {  // NOLINT
+    using other = HugePageAllocator<U, Threshold, std::max(Alignment, alignof(U)), UseHugeTlb>;  // NOLINT
+  };
+
+  static constexpr size_t kHugePageSize = size_t{2} << 20;
+  static constexpr size_t kThreshold = Threshold;
+
+  struct AllocationResult {
+    T* ptr;
+    size_t count;
+  };
+
+  HugePageAllocator() noexcept = default;
+  template <typename U, size_t OtherAlignment>
+  HugePageAllocator(const HugePageAllocator<U, Threshold, OtherAlignment, UseHugeTlb>& /*other*/) noexcept {  // NOLINT
+  }
+
+  [[nodiscard]] T* allocate(size_t count) {  // NOLINT
+    return allocate_at_least(count).ptr;
+  }
+
+  // Mapped blocks report the whole of their last huge page; deallocate rounds back to it.
+  [[nodiscard]] AllocationResult allocate_at_least(size_t count) {  // NOLINT
+    if (count > (static_cast<size_t>(-1) - kHugePageSize) / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    const size_t bytes = Bytes(count);
+    if (!IsMapped(bytes)) {
+      return {static_cast<T*>(::operator new(bytes, std::align_val_t(Alignment))), count};
+    }
+    const size_t mapped = RoundToHugePage(bytes);
+    return {static_cast<T*>(Map(mapped)), sizeof(T) <= kHugePageSize ? mapped / sizeof(T) : count};
+  }
+
+  void deallocate(T* ptr, size_t count) noexcept {  // NOLINT
+    const size_t bytes = Bytes(count);
+    if (IsMapped(bytes)) {
+      Unmap(ptr, RoundToHugePage(bytes));
+    } else {
+      ::operator delete(ptr, bytes, std::align_val_t(Alignment));
+    }
+  }
+
+  // Resizes mapped blocks with mremap; returns nullptr and keeps the old block otherwise.
+  [[nodiscard]] T* reallocate(T* ptr, size_t old_count, size_t new_count) noexcept {  // NOLINT
+#if defined(__linux__)
+    const size_t old_bytes = Bytes(old_count);
+    if (!UseHugeTlb && IsMapped(old_bytes) && new_count <= (static_cast<size_t>(-1) - kHugePageSize) / sizeof(T) &&
+        IsMapped(Bytes(new_count))) {
+      const size_t new_mapped = RoundToHugePage(Bytes(new_count));
+      void* moved = mremap(ptr, RoundToHugePage(old_bytes), new_mapped, MREMAP_MAYMOVE);
+      if (moved == MAP_FAILED) {
+        return nullptr;
+      }
+      madvise(moved, new_mapped, MADV_HUGEPAGE);
+      return static_cast<T*>(moved);
+    }
+#else
+    static_cast<void>(ptr);
+    static_cast<void>(old_count);
+    static_cast<void>(new_count);
+#endif
+    return nullptr;
+  }
+
+ private:
+  [[nodiscard]] static size_t Bytes(size_t count) noexcept {
+    return count * sizeof(T);
+  }
+  [[nodiscard]] static size_t RoundToHugePage(size_t bytes) noexcept {
+    return (bytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+  }
+
+#if defined(__linux__)
+  [[nodiscard]] static bool IsMapped(size_t bytes) noexcept {
+    return bytes >= Threshold;
+  }
+
+  // Maps one huge page more than needed and trims the ends to reach a 2 MiB boundary.
+  [[nodiscard]] static void* Map(size_t bytes) {
+    if constexpr (UseHugeTlb) {
+      void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (ptr != MAP_FAILED) {
+        return ptr;
+      }
+    }
+    void* raw = mmap(nullptr, bytes + kHugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    const auto address = reinterpret_cast<std::uintptr_t>(raw);
+    const size_t head = (kHugePageSize - address % kHugePageSize) % kHugePageSize;
+    auto* ptr = static_cast<unsigned char*>(raw) + head;
+    if (head != 0) {
+      munmap(raw, head);
+    }
+    munmap(ptr + bytes, kHugePageSize - head);
+    madvise(ptr, bytes, MADV_HUGEPAGE);
+    return ptr;
+  }
+  static void Unmap(void* ptr, size_t bytes) noexcept {
+    munmap(ptr, bytes);
+  }
+#else
+  [[nodiscard]] static bool IsMapped(size_t /*bytes*/) noexcept {
+    return false;
+  }
+  [[nodiscard]] static void* Map(size_t /*bytes*/) {
+    throw std::bad_alloc();
+  }
+  static void Unmap(void* /*ptr*/, size_t /*bytes*/) noexcept {
+  }
+#endif
+};
+
+template <typename T, size_t S, size_t A, bool H, typename U, size_t B>
+[[nodiscard]] bool operator==(const HugePageAllocator<T, S, A, H>& /*lhs*/,
+                              const HugePageAllocator<U, S, B, H>& /*rhs*/) noexcept {
+  return true;
+}
+
+template <typename T, size_t S, size_t A, bool H, typename U, size_t B>
+[[nodiscard]] bool operator!=(const HugePageAllocator<T, S, A, H>& /*lhs*/,
+                              const HugePageAllocator<U, S, B, H>& /*rhs*/) noexcept {
+  return false;
+}
+
+template <typename T, size_t Threshold, size_t Alignment, bool UseHugeTlb>
+struct AllowsTrivialRelocation<HugePageAllocator<T, Threshold, Alignment, UseHugeTlb>> : std::true_type {};
+
+template <typename T, size_t Alignment = 64, class GrowthPolicy = DoublingGrowth>
+using AlignedVector = Vector<T, AlignedAllocator<T, Alignment>, GrowthPolicy>;
+
+template <typename T, class GrowthPolicy = DoublingGrowth>
+using HugePageVector = Vector<T, HugePageAllocator<T>, GrowthPolicy>;
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_ALIGNED_ALLOCATOR_H_
@@ -0,0 +1,166 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_ARENA_ALLOCATOR_H_
+#define OOP_ASSIGNMENTS_VECTOR_ARENA_ALLOCATOR_H_
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+#include "vector.h"
+
+// Bump allocator over a list of upstream blocks. Individual deallocations only give memory back
+// when they free the most recent allocation; everything else is returned at once by Release or
+// the destructor, without touching the objects that lived in the arena. Not thread-safe.
+class Arena : public std::pmr::memory_resource {
+ public:
+  explicit Arena(size_t block_size = 64 * 1024,
+                 std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+      : upstream_(upstream), next_block_size_(block_size) {
+  }
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  ~Arena() override {
+    Release();
+  }
+
+  void Release() noexcept {
+    while (head_ != nullptr) {
+      auto next = head_->next;
+      upstream_->deallocate(head_, head_->size, alignof(Block));
+      head_ = next;
+    }
+    top_ = nullptr;
+    end_ = nullptr;
+    bytes_allocated_ = 0;
+  }
+
+  [[nodiscard]] size_t BytesAllocated() const noexcept {
+    return bytes_allocated_;
+  }
+  [[nodiscard]] std::pmr::memory_resource* Upstream() const noexcept {
+    return upstream_;
+  }
+
+ private:
+  struct Block {
+    Block* next;
+    size_t size;
+  };
+
+  [[nodiscard]] static size_t Padding(const char* ptr, size_t alignment) noexcept {
+    const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+    return (alignment - address % alignment) % alignment;
+  }
+
+  // Measured from top_, so that no pointer past end_ is ever formed.
+  [[nodiscard]] bool Fits(size_t bytes, size_t alignment) const noexcept {
+    if (top_ == nullptr) {
+      return false;
+    }
+    const auto room = static_cast<size_t>(end_ - top_);
+    const size_t padding = Padding(top_, alignment);
+    return padding <= room && bytes <= room - padding;
+  }
+
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    if (!Fits(bytes, alignment)) {
+      if (bytes > static_cast<size_t>(-1) - alignment) {
+        throw std::bad_alloc();
+      }
+      AddBlock(bytes + alignment);
+    }
+    char* result = top_ + Padding(top_, alignment);
+    top_ = result + bytes;
+    bytes_allocated_ += bytes;
+    return result;
+  }
+
+  void do_deallocate(void* ptr, size_t bytes, size_t /*alignment*/) override {
+    if (static_cast<char*>(ptr) + bytes == top_) {
+      top_ = static_cast<char*>(ptr);
+      bytes_allocated_ -= bytes;
+    }
+  }
+
+  [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  // Sizes are whole multiples of kBlockAlignment, so that every block ends on an aligned address.
+  void AddBlock(size_t min_bytes) {
+    if (min_bytes > static_cast<size_t>(-1) - sizeof(Block)) {
+      throw std::bad_alloc();
+    }
+    const size_t wanted = std::max(next_block_size_, min_bytes + sizeof(Block));
+    if (wanted > static_cast<size_t>(-1) - kBlockAlignment) {
+      throw std::bad_alloc();
+    }
+    const size_t size = (wanted + kBlockAlignment - 1) / kBlockAlignment * kBlockAlignment;
+    auto block = static_cast<Block*>(upstream_->allocate(size, alignof(Block)));
+    block->next = head_;
+    block->size = size;
+    head_ = block;
+    top_ = reinterpret_cast<char*>(block + 1);
+    end_ = reinterpret_cast<char*>(block) + size;
+    next_block_size_ = size <= static_cast<size_t>(-1) / 2 ? size * 2 : size;
+  }
+
+  static constexpr size_t kBlockAlignment = alignof(std::max_align_t);
+
+  std::pmr::memory_resource* upstream_;
+  size_t next_block_size_;
+  Block* head_{nullptr};
+  char* top_{nullptr};
+  char* end_{nullptr};
+  size_t bytes_allocated_{0};
+};
+
+// Typed handle to an Arena. Like polymorphic_allocator it does not propagate on copy, move or
+// swap, so containers keep the arena they were created with.
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;  // NOLINT
+
+  explicit ArenaAllocator(Arena& arena) noexcept : arena_(&arena) {
+  }
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.GetArena()) {  // NOLINT
+  }
+
+  [[nodiscard]] T* allocate(size_t count) {  // NOLINT
+    if (count > std::allocator_traits<ArenaAllocator>::max_size(*this)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T*>(arena_->allocate(count * sizeof(T), alignof(T)));
+  }
+  void deallocate(T* ptr, size_t count) noexcept {  // NOLINT
+    arena_->deallocate(ptr, count * sizeof(T), alignof(T));
+  }
+
+  [[nodiscard]] Arena* GetArena() const noexcept {
+    return arena_;
+  }
+
+ private:
+  Arena* arena_;
+};
+
+template <typename T, typename U>
+[[nodiscard]] bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept {
+  return lhs.GetArena() == rhs.GetArena();
+}
+
+template <typename T, typename U>
+[[nodiscard]] bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+template <typename T>
+struct AllowsTrivialRelocation<ArenaAllocator<T>> : std::true_type {};
+
+template <typename T, class GrowthPolicy = DoublingGrowth>
+using ArenaVector = Vector<T, ArenaAllocator<T>, GrowthPolicy>;
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_ARENA_ALLOCATOR_H_
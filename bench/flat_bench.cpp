@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+
+#include "../flat_map.h"
+
+// Lookups of present keys in FlatMap, with either search policy, against std::map.
+
+namespace {
+
+// Built in bulk: one sort for FlatMap, instead of a quadratic series of inserts.
+template <class M>
+M Make(Vector<int> keys, Vector<int> values) {
+  return M(std::move(keys), std::move(values));
+}
+template <>
+std::map<int, int> Make<std::map<int, int>>(Vector<int> keys, Vector<int> values) {
+  std::map<int, int> map;
+  for (size_t i = 0; i < keys.Size(); ++i) {
+    map.insert({keys[i], values[i]});
+  }
+  return map;
+}
+template <class M>
+int Lookup(const M& map, int key) {
+  return *map.FindValue(key);
+}
+template <class K, class V>
+int Lookup(const std::map<K, V>& map, int key) {
+  return map.find(key)->second;
+}
+
+template <class M>
+void BM_Lookup(benchmark::State& state) {
+  const auto count = static_cast<int>(state.range(0));
+  Vector<int> keys;
+  Vector<int> values;
+  std::mt19937 rng(1);
+  for (int i = 0; i < count; ++i) {
+    keys.PushBack(static_cast<int>(rng()));
+    values.PushBack(i);
+  }
+  const M map = Make<M>(keys, values);
+  std::shuffle(keys.begin(), keys.end(), rng);
+  size_t next = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Lookup(map, keys[next]));
+    next = next + 1 == keys.Size() ? 0 : next + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Lookup, FlatMap<int, int>)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Lookup, FlatMap<int, int, std::less<int>, EytzingerSearch>)
+    ->RangeMultiplier(16)
+    ->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Lookup, std::map<int, int>)->RangeMultiplier(16)->Range(16, 1 << 20);
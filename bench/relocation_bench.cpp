@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "../vector.h"
+
+namespace {
+
+// Same layout as int, but with user-provided special members, so by default it takes the
+// element-by-element move + destroy path on every reallocation.
+template <bool kRelocatable>
+struct WrappedInt {
+  WrappedInt(int v) : value(v) {  // NOLINT
+  }
+  WrappedInt(const WrappedInt& other) : value(other.value) {
+  }
+  WrappedInt(WrappedInt&& other) noexcept : value(other.value) {
+  }
+  ~WrappedInt() {
+  }
+  int value;
+};
+
+using OpaqueInt = WrappedInt<false>;
+using RelocatableInt = WrappedInt<true>;
+
+}  // namespace
+
+template <>
+struct IsTriviallyRelocatable<RelocatableInt> : std::true_type {};
+
+namespace {
+
+template <typename T>
+void BM_PushBack(benchmark::State& state) {
+  const auto count = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Vector<T> vec;
+    for (int i = 0; i < count; ++i) {
+      vec.PushBack(T(i));
+    }
+    benchmark::DoNotOptimize(vec.Data());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+void BM_PushBackUniquePtr(benchmark::State& state) {
+  const auto count = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Vector<std::unique_ptr<int>> vec;
+    for (int i = 0; i < count; ++i) {
+      vec.PushBack(nullptr);
+    }
+    benchmark::DoNotOptimize(vec.Data());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_PushBack, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_PushBack, OpaqueInt)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_PushBack, RelocatableInt)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_PushBackUniquePtr)->Range(1 << 10, 1 << 20);
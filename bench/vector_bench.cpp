@@ -0,0 +1,312 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "../pooled_allocator.h"
+#include "../vector.h"
+
+// Vector against std::vector on the same workloads. Every benchmark is instantiated for both
+// containers, so that /N rows of one name can be compared directly, and across commits via
+// the vector_bench_json target.
+
+namespace {
+
+// Copyable type whose move constructor may throw, so that reallocation has to copy.
+struct ThrowingMove {
+  ThrowingMove() = default;
+  ThrowingMove(int v) : value(32, static_cast<char>('a' + v % 26)) {  // NOLINT
+  }
+  ThrowingMove(const ThrowingMove& other) = default;
+  ThrowingMove(ThrowingMove&& other) noexcept(false) : value(std::move(other.value)) {
+  }
+  ThrowingMove& operator=(const ThrowingMove& other) = default;
+  ThrowingMove& operator=(ThrowingMove&& other) noexcept(false) {
+    value = std::move(other.value);
+    return *this;
+  }
+  bool operator==(const ThrowingMove& other) const noexcept {
+    return value == other.value;
+  }
+  bool operator<(const ThrowingMove& other) const noexcept {
+    return value < other.value;
+  }
+  std::string value;
+};
+
+template <typename T>
+T MakeValue(int i) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    // Longer than the small-string buffer, so every element owns a heap block.
+    return std::string(32, static_cast<char>('a' + i % 26));
+  } else {
+    return T(i);
+  }
+}
+
+// Something to sum while iterating, which touches each element.
+size_t Weight(int value) {
+  return static_cast<size_t>(value);
+}
+size_t Weight(const std::string& value) {
+  return value.size();
+}
+size_t Weight(const ThrowingMove& value) {
+  return value.value.size();
+}
+
+template <class C>
+using ElementOf = std::remove_const_t<std::remove_reference_t<decltype(*std::declval<C&>().begin())>>;
+
+// Uniform spelling of the operations that differ in name between the two containers.
+template <typename T>
+void PushBack(std::vector<T>& vec, const T& value) {
+  vec.push_back(value);
+}
+template <typename T, class A, class G>
+void PushBack(Vector<T, A, G>& vec, const T& value) {
+  vec.PushBack(value);
+}
+// std::vector has no unchecked append, so its baseline is push_back.
+template <typename T>
+void UncheckedPushBack(std::vector<T>& vec, const T& value) {
+  vec.push_back(value);
+}
+template <typename T, class A, class G>
+void UncheckedPushBack(Vector<T, A, G>& vec, const T& value) {
+  vec.UncheckedPushBack(value);
+}
+template <typename T, class... Args>
+void EmplaceBack(std::vector<T>& vec, Args&&... args) {
+  vec.emplace_back(std::forward<Args>(args)...);
+}
+template <typename T, class A, class G, class... Args>
+void EmplaceBack(Vector<T, A, G>& vec, Args&&... args) {
+  vec.EmplaceBack(std::forward<Args>(args)...);
+}
+template <typename T>
+void Reserve(std::vector<T>& vec, size_t capacity) {
+  vec.reserve(capacity);
+}
+template <typename T, class A, class G>
+void Reserve(Vector<T, A, G>& vec, size_t capacity) {
+  vec.Reserve(capacity);
+}
+template <typename T>
+void Resize(std::vector<T>& vec, size_t size) {
+  vec.resize(size);
+}
+template <typename T, class A, class G>
+void Resize(Vector<T, A, G>& vec, size_t size) {
+  vec.Resize(size);
+}
+template <typename T>
+size_t Capacity(const std::vector<T>& vec) {
+  return vec.capacity();
+}
+template <typename T, class A, class G>
+size_t Capacity(const Vector<T, A, G>& vec) {
+  return vec.Capacity();
+}
+template <typename T>
+const void* Data(const std::vector<T>& vec) {
+  return vec.data();
+}
+template <typename T, class A, class G>
+const void* Data(const Vector<T, A, G>& vec) {
+  return vec.Data();
+}
+
+template <class C>
+C Filled(int count) {
+  C vec;
+  Reserve(vec, static_cast<size_t>(count));
+  for (int i = 0; i < count; ++i) {
+    PushBack(vec, MakeValue<ElementOf<C>>(i));
+  }
+  return vec;
+}
+
+template <class C>
+void BM_PushBack(benchmark::State& state) {
+  using T = ElementOf<C>;
+  const auto count = static_cast<int>(state.range(0));
+  const T value = MakeValue<T>(1);
+  for (auto _ : state) {
+    C vec;
+    for (int i = 0; i < count; ++i) {
+      PushBack(vec, value);
+    }
+    benchmark::DoNotOptimize(Data(vec));
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <class C>
+void BM_EmplaceBack(benchmark::State& state) {
+  const auto count = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    C vec;
+    for (int i = 0; i < count; ++i) {
+      EmplaceBack(vec, MakeValue<ElementOf<C>>(i));
+    }
+    benchmark::DoNotOptimize(Data(vec));
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <class C>
+void BM_ReservedPushBack(benchmark::State& state) {
+  using T = ElementOf<C>;
+  const auto count = static_cast<int>(state.range(0));
+  const T value = MakeValue<T>(1);
+  for (auto _ : state) {
+    C vec;
+    Reserve(vec, static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+      PushBack(vec, value);
+    }
+    benchmark::DoNotOptimize(Data(vec));
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <class C>
+void BM_UncheckedPushBack(benchmark::State& state) {
+  using T = ElementOf<C>;
+  const auto count = static_cast<int>(state.range(0));
+  const T value = MakeValue<T>(1);
+  for (auto _ : state) {
+    C vec;
+    Reserve(vec, static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+      UncheckedPushBack(vec, value);
+    }
+    benchmark::DoNotOptimize(Data(vec));
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+// The reallocation count depends only on the growth policy, so it is exact across runs.
+template <class C>
+void BM_Reallocations(benchmark::State& state) {
+  using T = ElementOf<C>;
+  const auto count = static_cast<int>(state.range(0));
+  const T value = MakeValue<T>(1);
+  size_t reallocations = 0;
+  for (auto _ : state) {
+    C vec;
+    reallocations = 0;
+    for (int i = 0; i < count; ++i) {
+      const size_t capacity = Capacity(vec);
+      PushBack(vec, value);
+      reallocations += Capacity(vec) != capacity ? 1 : 0;
+    }
+    benchmark::DoNotOptimize(Data(vec));
+  }
+  state.counters["reallocations"] = static_cast<double>(reallocations);
+}
+
+template <class C>
+void BM_Resize(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  for (auto _ : state) {
+    C vec;
+    Resize(vec, count);
+    benchmark::DoNotOptimize(Data(vec));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class C>
+void BM_CopyConstruct(benchmark::State& state) {
+  const C source = Filled<C>(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    C copy(source);
+    benchmark::DoNotOptimize(Data(copy));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class C>
+void BM_CopyAssign(benchmark::State& state) {
+  const C source = Filled<C>(static_cast<int>(state.range(0)));
+  C target = Filled<C>(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    target = source;
+    benchmark::DoNotOptimize(Data(target));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class C>
+void BM_MoveConstruct(benchmark::State& state) {
+  C source = Filled<C>(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    C moved(std::move(source));
+    benchmark::DoNotOptimize(Data(moved));
+    source = std::move(moved);
+  }
+}
+
+template <class C>
+void BM_Iterate(benchmark::State& state) {
+  const C vec = Filled<C>(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    size_t checksum = 0;
+    for (const auto& value : vec) {
+      checksum += Weight(value);
+    }
+    benchmark::DoNotOptimize(checksum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Equal contents, so that operator== and operator< have to look at every element.
+template <class C>
+void BM_Equal(benchmark::State& state) {
+  const C lhs = Filled<C>(static_cast<int>(state.range(0)));
+  const C rhs = lhs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs == rhs);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class C>
+void BM_Less(benchmark::State& state) {
+  const C lhs = Filled<C>(static_cast<int>(state.range(0)));
+  const C rhs = lhs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs < rhs);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+#define VECTOR_BENCH(name, type, ...)                                                  \
+  BENCHMARK_TEMPLATE(name, Vector<type>)->RangeMultiplier(16)->Range(__VA_ARGS__); \
+  BENCHMARK_TEMPLATE(name, std::vector<type>)->RangeMultiplier(16)->Range(__VA_ARGS__)
+
+#define VECTOR_BENCH_TYPES(name, ...)             \
+  VECTOR_BENCH(name, int, __VA_ARGS__);           \
+  VECTOR_BENCH(name, std::string, __VA_ARGS__);   \
+  VECTOR_BENCH(name, ThrowingMove, __VA_ARGS__)
+
+VECTOR_BENCH_TYPES(BM_PushBack, 16, 1 << 20);
+VECTOR_BENCH_TYPES(BM_EmplaceBack, 16, 1 << 20);
+VECTOR_BENCH_TYPES(BM_ReservedPushBack, 16, 1 << 20);
+VECTOR_BENCH_TYPES(BM_UncheckedPushBack, 16, 1 << 20);
+VECTOR_BENCH(BM_Reallocations, int, 1 << 10, 1 << 20);
+VECTOR_BENCH_TYPES(BM_Resize, 16, 1 << 20);
+VECTOR_BENCH_TYPES(BM_CopyConstruct, 16, 1 << 16);
+VECTOR_BENCH_TYPES(BM_CopyAssign, 16, 1 << 16);
+VECTOR_BENCH(BM_MoveConstruct, std::string, 1 << 10, 1 << 10);
+VECTOR_BENCH_TYPES(BM_Iterate, 16, 1 << 20);
+VECTOR_BENCH_TYPES(BM_Equal, 16, 1 << 20);
+VECTOR_BENCH_TYPES(BM_Less, 16, 1 << 20);
+
+// Temporary vectors built and dropped in a loop, the churn PooledAllocator recycles.
+BENCHMARK_TEMPLATE(BM_PushBack, PooledVector<int>)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_PushBack, PooledVector<std::string>)->RangeMultiplier(16)->Range(16, 1 << 20);
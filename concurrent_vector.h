@@ -0,0 +1,241 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_CONCURRENT_VECTOR_H_
+#define OOP_ASSIGNMENTS_VECTOR_CONCURRENT_VECTOR_H_
+#include <atomic>
+#include <cstdint>
+
+#include "vector.h"
+
+// Append-only vector for many concurrent producers. Elements live in segments of doubling size
+// that are never moved, so references stay valid; EmplaceBack claims its slot with a single
+// fetch_add and installs missing segments with a compare-and-swap, without taking locks.
+// Every slot carries a ready bit, published once its element is constructed: a slot whose
+// construction threw stays empty but keeps its index, and ToVector copies the ready elements
+// in index order. Reading an element is safe once the EmplaceBack that built it returned.
+// The allocator is shared by all producers and has to be thread-safe.
+template <typename T, class Allocator = std::allocator<T>>
+class ConcurrentVector {
+ public:
+  using ValueType = T;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+
+  ConcurrentVector() noexcept(noexcept(Allocator())) = default;
+  explicit ConcurrentVector(const Allocator& alloc) noexcept : alloc_(alloc) {
+  }
+  ConcurrentVector(const ConcurrentVector&) = delete;
+  ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+  ~ConcurrentVector() {
+    const size_t size = size_.load(std::memory_order_acquire);
+    for (size_t segment = 0; segment < kSegmentCount; ++segment) {
+      Segment* ptr = segments_[segment].load(std::memory_order_acquire);
+      if (ptr == nullptr) {
+        continue;
+      }
+      const size_t begin = SegmentBegin(segment);
+      const size_t end = std::min(size, begin + SegmentSize(segment));
+      for (size_t idx = begin; idx < end; ++idx) {
+        if (IsReady(*ptr, idx - begin)) {
+          AllocTraits::destroy(alloc_, ptr->items + (idx - begin));
+        }
+      }
+      FreeSegment(ptr, segment);
+    }
+  }
+
+  // Number of claimed slots, including those whose elements are still being constructed.
+  [[nodiscard]] SizeType Size() const noexcept {
+    return size_.load(std::memory_order_acquire);
+  }
+  [[nodiscard]] bool Empty() const noexcept {
+    return Size() == 0;
+  }
+  // Slots backed by the segments allocated so far.
+  [[nodiscard]] SizeType Capacity() const noexcept {
+    size_t segment = 0;
+    while (segment < kSegmentCount && segments_[segment].load(std::memory_order_acquire) != nullptr) {
+      ++segment;
+    }
+    return SegmentBegin(segment);
+  }
+  [[nodiscard]] Allocator GetAllocator() const noexcept {
+    return alloc_;
+  }
+
+  [[nodiscard]] ConstReference operator[](size_t idx) const noexcept {
+    const auto [segment, offset] = Locate(idx);
+    return segments_[segment].load(std::memory_order_acquire)->items[offset];
+  }
+  [[nodiscard]] Reference operator[](size_t idx) noexcept {
+    return const_cast<T&>(const_cast<const ConcurrentVector&>(*this)[idx]);
+  }
+  // Throws std::out_of_range unless the element at idx has been constructed.
+  [[nodiscard]] ConstReference At(size_t idx) const {
+    if (idx >= Size()) {
+      throw std::out_of_range("");
+    }
+    const auto [segment, offset] = Locate(idx);
+    const Segment* ptr = segments_[segment].load(std::memory_order_acquire);
+    if (ptr == nullptr || !IsReady(*ptr, offset)) {
+      throw std::out_of_range("");
+    }
+    return ptr->items[offset];
+  }
+  [[nodiscard]] Reference At(size_t idx) {
+    return const_cast<T&>(const_cast<const ConcurrentVector&>(*this).At(idx));
+  }
+
+  // Allocates the segments for the first `capacity` slots up front.
+  void Reserve(size_t capacity) {
+    for (size_t segment = 0; segment < kSegmentCount && SegmentBegin(segment) < capacity; ++segment) {
+      EnsureSegment(segment);
+    }
+  }
+
+  // Returns a reference to the new element, which stays valid for the lifetime of the vector.
+  template <class... Args>
+  Reference EmplaceBack(Args&&... args) {
+    const size_t idx = size_.fetch_add(1, std::memory_order_relaxed);
+    const auto [segment, offset] = Locate(idx);
+    Segment& ptr = EnsureSegment(segment);
+    AllocTraits::construct(alloc_, ptr.items + offset, std::forward<Args>(args)...);
+    return Publish(ptr, offset);
+  }
+  Reference PushBack(const T& value) {
+    return EmplaceBack(value);
+  }
+  Reference PushBack(T&& value) {
+    return EmplaceBack(std::move(value));
+  }
+
+  // Copies the elements constructed so far into a contiguous Vector, skipping empty slots.
+  template <class VectorAllocator = Allocator, class Growth = DoublingGrowth>
+  [[nodiscard]] Vector<T, VectorAllocator, Growth> ToVector(const VectorAllocator& alloc = VectorAllocator()) const {
+    Vector<T, VectorAllocator, Growth> result(alloc);
+    const size_t size = Size();
+    result.Reserve(size);
+    for (size_t segment = 0; segment < kSegmentCount && SegmentBegin(segment) < size; ++segment) {
+      const Segment* ptr = segments_[segment].load(std::memory_order_acquire);
+      if (ptr == nullptr) {
+        continue;
+      }
+      const size_t count = std::min(SegmentSize(segment), size - SegmentBegin(segment));
+      for (size_t offset = 0; offset < count; ++offset) {
+        if (IsReady(*ptr, offset)) {
+          result.PushBack(ptr->items[offset]);
+        }
+      }
+    }
+    return result;
+  }
+
+ private:
+  using AllocTraits = std::allocator_traits<Allocator>;
+
+  struct Segment {
+    T* items;
+    std::atomic<uint64_t>* ready;
+  };
+
+  using SegmentAllocator = typename AllocTraits::template rebind_alloc<Segment>;
+  using SegmentTraits = std::allocator_traits<SegmentAllocator>;
+  using ReadyAllocator = typename AllocTraits::template rebind_alloc<std::atomic<uint64_t>>;
+  using ReadyTraits = std::allocator_traits<ReadyAllocator>;
+
+  static constexpr size_t Log2(size_t value) noexcept {
+    size_t log = 0;
+    while (value > 1) {
+      value >>= 1;
+      ++log;
+    }
+    return log;
+  }
+
+  // The first segment spans about a page; segment k holds kFirstSize << k slots.
+  static constexpr size_t kFirstShift = Log2(std::max<size_t>(4096 / sizeof(T), 1));
+  static constexpr size_t kFirstSize = size_t{1} << kFirstShift;
+  static constexpr size_t kSegmentCount = 8 * sizeof(size_t) - kFirstShift;
+
+  [[nodiscard]] static constexpr size_t SegmentSize(size_t segment) noexcept {
+    return kFirstSize << segment;
+  }
+  [[nodiscard]] static constexpr size_t SegmentBegin(size_t segment) noexcept {
+    return segment == kSegmentCount ? static_cast<size_t>(-1) : (kFirstSize << segment) - kFirstSize;
+  }
+
+  struct Position {
+    size_t segment;
+    size_t offset;
+  };
+
+  [[nodiscard]] static Position Locate(size_t idx) noexcept {
+    const size_t biased = idx + kFirstSize;
+#if defined(__GNUC__)
+    const auto log = static_cast<size_t>(8 * sizeof(unsigned long long) - 1 - __builtin_clzll(biased));
+#else
+    const size_t log = Log2(biased);
+#endif
+    return {log - kFirstShift, biased - (size_t{1} << log)};
+  }
+
+  [[nodiscard]] static bool IsReady(const Segment& segment, size_t offset) noexcept {
+    return (segment.ready[offset / 64].load(std::memory_order_acquire) >> (offset % 64) & 1) != 0;
+  }
+
+  Reference Publish(Segment& segment, size_t offset) noexcept {
+    segment.ready[offset / 64].fetch_or(uint64_t{1} << (offset % 64), std::memory_order_release);
+    return segment.items[offset];
+  }
+
+  Segment& EnsureSegment(size_t segment) {
+    Segment* ptr = segments_[segment].load(std::memory_order_acquire);
+    if (ptr != nullptr) {
+      return *ptr;
+    }
+    Segment* fresh = AllocateSegment(segment);
+    if (!segments_[segment].compare_exchange_strong(ptr, fresh, std::memory_order_acq_rel)) {
+      FreeSegment(fresh, segment);
+      return *ptr;
+    }
+    return *fresh;
+  }
+
+  [[nodiscard]] Segment* AllocateSegment(size_t segment) {
+    const size_t size = SegmentSize(segment);
+    const size_t words = (size + 63) / 64;
+    SegmentAllocator segment_alloc(alloc_);
+    ReadyAllocator ready_alloc(alloc_);
+    Segment* ptr = SegmentTraits::allocate(segment_alloc, 1);
+    std::atomic<uint64_t>* ready = nullptr;
+    try {
+      ready = ReadyTraits::allocate(ready_alloc, words);
+      for (size_t i = 0; i < words; ++i) {
+        ::new (static_cast<void*>(ready + i)) std::atomic<uint64_t>(0);
+      }
+      ::new (static_cast<void*>(ptr)) Segment{AllocTraits::allocate(alloc_, size), ready};
+    } catch (...) {
+      if (ready != nullptr) {
+        ReadyTraits::deallocate(ready_alloc, ready, words);
+      }
+      SegmentTraits::deallocate(segment_alloc, ptr, 1);
+      throw;
+    }
+    return ptr;
+  }
+
+  void FreeSegment(Segment* ptr, size_t segment) noexcept {
+    const size_t size = SegmentSize(segment);
+    SegmentAllocator segment_alloc(alloc_);
+    ReadyAllocator ready_alloc(alloc_);
+    AllocTraits::deallocate(alloc_, ptr->items, size);
+    ReadyTraits::deallocate(ready_alloc, ptr->ready, (size + 63) / 64);
+    SegmentTraits::deallocate(segment_alloc, ptr, 1);
+  }
+
+  Allocator alloc_{Allocator{}};
+  std::atomic<size_t> size_{0};
+  std::atomic<Segment*> segments_[kSegmentCount]{};
+};
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_CONCURRENT_VECTOR_H_
@@ -0,0 +1,329 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_FLAT_MAP_H_
+#define OOP_ASSIGNMENTS_VECTOR_FLAT_MAP_H_
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include "flat_set.h"
+#include "vector.h"
+#include "vector_view.h"
+
+// Ordered map of unique keys with the keys and the values in two Vectors, sorted by key, so
+// that a lookup only walks the keys. Entries are addressed by their position: Find returns
+// one, or kNpos, and KeyAt/ValueAt (or the Keys/Values views) read it. Positions change when
+// keys are inserted or erased before them. As with FlatSet, batches should go through the
+// container Insert or InsertSorted, which merge once.
+template <typename K, typename V, class Compare = std::less<K>, class Search = BinarySearch,
+          class KeyAllocator = std::allocator<K>, class ValueAllocator = std::allocator<V>>
+class FlatMap {
+ public:
+  using KeyType = K;
+  using MappedType = V;
+  using SizeType = size_t;
+  using KeyContainer = Vector<K, KeyAllocator>;
+  using ValueContainer = Vector<V, ValueAllocator>;
+
+  static constexpr size_t kNpos = static_cast<size_t>(-1);
+
+  constexpr FlatMap() = default;
+  explicit constexpr FlatMap(const Compare& comp) : comp_(comp) {
+  }
+  // values[i] belongs to keys[i]. Sorts the entries by key and drops duplicates, keeping the
+  // first entry of equivalent keys.
+  constexpr FlatMap(KeyContainer keys, ValueContainer values, const Compare& comp = Compare())
+      : keys_(std::move(keys)), values_(std::move(values)), comp_(comp) {
+    SortUnique(keys_, values_);
+    index_.Reserve(keys_.Size());
+    Reindex();
+  }
+  constexpr FlatMap(std::initializer_list<std::pair<K, V>> init_lst, const Compare& comp = Compare())
+      : FlatMap(KeysOf(init_lst), ValuesOf(init_lst), comp) {
+  }
+
+  [[nodiscard]] constexpr SizeType Size() const noexcept {
+    return keys_.Size();
+  }
+  [[nodiscard]] constexpr bool Empty() const noexcept {
+    return keys_.Empty();
+  }
+  [[nodiscard]] constexpr SizeType Capacity() const noexcept {
+    return std::min(keys_.Capacity(), values_.Capacity());
+  }
+  [[nodiscard]] constexpr ConstVectorView<K> Keys() const noexcept {
+    return keys_;
+  }
+  [[nodiscard]] constexpr VectorView<V> Values() noexcept {
+    return values_;
+  }
+  [[nodiscard]] constexpr ConstVectorView<V> Values() const noexcept {
+    return values_;
+  }
+  [[nodiscard]] constexpr const K& KeyAt(size_t pos) const noexcept {
+    return keys_[pos];
+  }
+  [[nodiscard]] constexpr V& ValueAt(size_t pos) noexcept {
+    return values_[pos];
+  }
+  [[nodiscard]] constexpr const V& ValueAt(size_t pos) const noexcept {
+    return values_[pos];
+  }
+  [[nodiscard]] constexpr const Compare& KeyComp() const noexcept {
+    return comp_;
+  }
+
+  constexpr void Reserve(size_t capacity) {
+    index_.Reserve(capacity);
+    keys_.Reserve(capacity);
+    values_.Reserve(capacity);
+  }
+  constexpr void ShrinkToFit() {
+    keys_.ShrinkToFit();
+    values_.ShrinkToFit();
+    index_.ShrinkToFit();
+  }
+  constexpr void Clear() noexcept {
+    keys_.Clear();
+    values_.Clear();
+    Reindex();
+  }
+
+  // Position of the first key not less than key, Size() if there is none.
+  [[nodiscard]] constexpr size_t LowerBound(const K& key) const {
+    return index_.LowerBound(keys_.Data(), keys_.Size(), key, comp_);
+  }
+  [[nodiscard]] constexpr size_t UpperBound(const K& key) const {
+    return static_cast<size_t>(std::upper_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin());
+  }
+  [[nodiscard]] constexpr size_t Find(const K& key) const {
+    const size_t pos = LowerBound(key);
+    return pos != keys_.Size() && !comp_(key, keys_[pos]) ? pos : kNpos;
+  }
+  [[nodiscard]] constexpr bool Contains(const K& key) const {
+    return Find(key) != kNpos;
+  }
+  [[nodiscard]] constexpr SizeType Count(const K& key) const {
+    return Contains(key) ? 1 : 0;
+  }
+  // nullptr if there is no such key.
+  [[nodiscard]] constexpr V* FindValue(const K& key) {
+    const size_t pos = Find(key);
+    return pos == kNpos ? nullptr : values_.Data() + pos;
+  }
+  [[nodiscard]] constexpr const V* FindValue(const K& key) const {
+    const size_t pos = Find(key);
+    return pos == kNpos ? nullptr : values_.Data() + pos;
+  }
+  [[nodiscard]] constexpr V& At(const K& key) {
+    return values_[FindOrThrow(key)];
+  }
+  [[nodiscard]] constexpr const V& At(const K& key) const {
+    return values_[FindOrThrow(key)];
+  }
+  constexpr V& operator[](const K& key) {
+    return values_[TryEmplace(key).first];
+  }
+
+  // Each returns the position of key and whether it was inserted.
+  constexpr std::pair<size_t, bool> Insert(const K& key, const V& value) {
+    return TryEmplace(key, value);
+  }
+  constexpr std::pair<size_t, bool> Insert(K&& key, V&& value) {
+    return TryEmplace(std::move(key), std::move(value));
+  }
+  template <class Key, class... Args>
+  constexpr std::pair<size_t, bool> TryEmplace(Key&& key, Args&&... args) {
+    const size_t pos = LowerBound(key);
+    if (pos != keys_.Size() && !comp_(key, keys_[pos])) {
+      return {pos, false};
+    }
+    index_.Reserve(keys_.Size() + 1);
+    keys_.EmplaceAt(keys_.begin() + pos, std::forward<Key>(key));
+    try {
+      values_.EmplaceAt(values_.begin() + pos, std::forward<Args>(args)...);
+    } catch (...) {
+      keys_.Erase(keys_.begin() + pos);
+      throw;
+    }
+    Reindex();
+    return {pos, true};
+  }
+  template <class Key, class Value>
+  constexpr std::pair<size_t, bool> InsertOrAssign(Key&& key, Value&& value) {
+    const auto [pos, inserted] = TryEmplace(std::forward<Key>(key), std::forward<Value>(value));
+    if (!inserted) {
+      values_[pos] = std::forward<Value>(value);
+    }
+    return {pos, inserted};
+  }
+  // Merges a batch of entries in with one pass and one allocation, values[i] belonging to
+  // keys[i]. Entries already in the map win over new ones with equivalent keys, and the first
+  // of equivalent new ones wins over the rest.
+  constexpr void Insert(KeyContainer keys, ValueContainer values) {
+    SortUnique(keys, values);
+    Merge(keys, values);
+  }
+  // Like the container Insert, for keys already sorted by KeyComp().
+  constexpr void InsertSorted(KeyContainer keys, ValueContainer values) {
+    CheckSizes(keys, values);
+    Merge(keys, values);
+  }
+
+  // Returns the position of the entry that followed the erased one.
+  constexpr size_t EraseAt(size_t pos) {
+    keys_.Erase(keys_.begin() + pos);
+    values_.Erase(values_.begin() + pos);
+    Reindex();
+    return pos;
+  }
+  constexpr SizeType Erase(const K& key) {
+    const size_t pos = Find(key);
+    if (pos == kNpos) {
+      return 0;
+    }
+    EraseAt(pos);
+    return 1;
+  }
+  // Erases the entries for which pred(key, value) holds.
+  template <class Predicate>
+  constexpr SizeType EraseIf(Predicate pred) {
+    const size_t old_size = keys_.Size();
+    Compact(keys_, values_, [&](size_t /*kept*/, size_t pos) { return pred(keys_[pos], values_[pos]); });
+    Reindex();
+    return old_size - keys_.Size();
+  }
+
+  constexpr void Swap(FlatMap& other) noexcept {
+    keys_.Swap(other.keys_);
+    values_.Swap(other.values_);
+    std::swap(comp_, other.comp_);
+    std::swap(index_, other.index_);
+  }
+
+ private:
+  static constexpr KeyContainer KeysOf(std::initializer_list<std::pair<K, V>> init_lst) {
+    KeyContainer keys;
+    keys.Reserve(init_lst.size());
+    for (const auto& entry : init_lst) {
+      keys.PushBack(entry.first);
+    }
+    return keys;
+  }
+  static constexpr ValueContainer ValuesOf(std::initializer_list<std::pair<K, V>> init_lst) {
+    ValueContainer values;
+    values.Reserve(init_lst.size());
+    for (const auto& entry : init_lst) {
+      values.PushBack(entry.second);
+    }
+    return values;
+  }
+
+  static constexpr void CheckSizes(const KeyContainer& keys, const ValueContainer& values) {
+    if (keys.Size() != values.Size()) {
+      throw std::invalid_argument("");
+    }
+  }
+
+  [[nodiscard]] constexpr size_t FindOrThrow(const K& key) const {
+    const size_t pos = Find(key);
+    if (pos == kNpos) {
+      throw std::out_of_range("");
+    }
+    return pos;
+  }
+
+  // Moves the entries for which drop(last_kept, pos) is false to the front, in order, and
+  // erases the rest; last_kept is the position of the last entry kept so far, kNpos before.
+  template <class Drop>
+  static constexpr void Compact(KeyContainer& keys, ValueContainer& values, Drop drop) {
+    size_t kept = 0;
+    for (size_t pos = 0; pos < keys.Size(); ++pos) {
+      if (drop(kept == 0 ? kNpos : kept - 1, pos)) {
+        continue;
+      }
+      if (kept != pos) {
+        keys[kept] = std::move(keys[pos]);
+        values[kept] = std::move(values[pos]);
+      }
+      ++kept;
+    }
+    keys.Erase(keys.begin() + kept, keys.end());
+    values.Erase(values.begin() + kept, values.end());
+  }
+
+  // Sorts the entries by key through a permutation, and drops all but the first entry of
+  // each run of equivalent keys.
+  constexpr void SortUnique(KeyContainer& keys, ValueContainer& values) const {
+    CheckSizes(keys, values);
+    if (!std::is_sorted(keys.begin(), keys.end(), comp_)) {
+      Vector<size_t> order(keys.Size(), DefaultInitTag{});
+      std::iota(order.begin(), order.end(), size_t{0});
+      std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) { return comp_(keys[lhs], keys[rhs]); });
+      KeyContainer sorted_keys(keys.GetAllocator());
+      ValueContainer sorted_values(values.GetAllocator());
+      sorted_keys.Reserve(keys.Size());
+      sorted_values.Reserve(values.Size());
+      for (const size_t pos : order) {
+        sorted_keys.UncheckedPushBack(std::move(keys[pos]));
+        sorted_values.UncheckedPushBack(std::move(values[pos]));
+      }
+      keys = std::move(sorted_keys);
+      values = std::move(sorted_values);
+    }
+    Compact(keys, values, [&](size_t last_kept, size_t pos) {
+      return last_kept != kNpos && !comp_(keys[last_kept], keys[pos]);
+    });
+  }
+
+  // Merges sorted entries in, moving both sides into fresh buffers. Should a move
+  // throw halfway, the map is left empty.
+  constexpr void Merge(KeyContainer& keys, ValueContainer& values) {
+    if (keys.Empty()) {
+      return;
+    }
+    const size_t max_size = keys_.Size() + keys.Size();
+    index_.Reserve(max_size);
+    KeyContainer merged_keys(keys_.GetAllocator());
+    ValueContainer merged_values(values_.GetAllocator());
+    merged_keys.Reserve(max_size);
+    merged_values.Reserve(max_size);
+    try {
+      size_t old_pos = 0;
+      size_t new_pos = 0;
+      while (old_pos < keys_.Size() || new_pos < keys.Size()) {
+        if (new_pos == keys.Size() || (old_pos < keys_.Size() && !comp_(keys[new_pos], keys_[old_pos]))) {
+          merged_keys.UncheckedPushBack(std::move(keys_[old_pos]));
+          merged_values.UncheckedPushBack(std::move(values_[old_pos]));
+          ++old_pos;
+        } else {
+          // Old keys go first among equivalent ones, so this also drops new duplicates of them.
+          if (merged_keys.Empty() || comp_(merged_keys.Back(), keys[new_pos])) {
+            merged_keys.UncheckedPushBack(std::move(keys[new_pos]));
+            merged_values.UncheckedPushBack(std::move(values[new_pos]));
+          }
+          ++new_pos;
+        }
+      }
+    } catch (...) {
+      Clear();
+      throw;
+    }
+    keys_ = std::move(merged_keys);
+    values_ = std::move(merged_values);
+    Reindex();
+  }
+
+  constexpr void Reindex() noexcept {
+    index_.Build(keys_.Data(), keys_.Size());
+  }
+
+  KeyContainer keys_;
+  ValueContainer values_;
+  [[no_unique_address]] Compare comp_;
+  [[no_unique_address]] typename Search::template Index<K> index_;
+};
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_FLAT_MAP_H_
@@ -0,0 +1,345 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_FLAT_SET_H_
+#define OOP_ASSIGNMENTS_VECTOR_FLAT_SET_H_
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+#include "vector_view.h"
+
+// Search policies of FlatSet and FlatMap. An Index<K> is kept next to the sorted keys: Reserve
+// makes room for a number of keys up front, so that the Build that follows every change cannot
+// throw, and LowerBound returns the position of the first key not less than key.
+
+// Branch-free binary search over the sorted keys, with no extra memory.
+struct BinarySearch {
+  template <typename K>
+  class Index {
+   public:
+    constexpr void Reserve(size_t /*count*/) noexcept {
+    }
+    constexpr void Build(const K* /*keys*/, size_t /*count*/) noexcept {
+    }
+    constexpr void ShrinkToFit() noexcept {
+    }
+
+    template <class Compare>
+    [[nodiscard]] constexpr size_t LowerBound(const K* keys, size_t count, const K& key,
+                                              const Compare& comp) const {
+      if (count == 0) {
+        return 0;
+      }
+      const K* base = keys;
+      while (count > 1) {
+        const size_t half = count / 2;
+        base += comp(base[half], key) ? half : 0;
+        count -= half;
+      }
+      return static_cast<size_t>(base - keys) + (comp(*base, key) ? 1 : 0);
+    }
+  };
+};
+
+// Copies the keys into Eytzinger (breadth-first) order, so that the first levels of every
+// search share a few cache lines and the next node is always at 2k or 2k + 1. It costs a copy
+// of the keys and a rank per key, and a rebuild on every change, so it is only for tables
+// that are read much more often than written, and only worth it where bench/flat_bench shows
+// that it beats BinarySearch on the target. Keys must be trivially copyable.
+struct EytzingerSearch {
+  template <typename K>
+  class Index {
+    static_assert(std::is_trivially_copyable_v<K>, "EytzingerSearch copies keys into its index");
+
+   public:
+    constexpr void Reserve(size_t count) {
+      nodes_.Reserve(count + 1);
+    }
+    // Node k has children 2k and 2k + 1; node 0 is unused.
+    constexpr void Build(const K* keys, size_t count) noexcept {
+      if (count == 0) {
+        nodes_.Clear();
+        return;
+      }
+      nodes_.ResizeDefaultInit(count + 1);
+      size_t rank = 0;
+      BuildSubtree(keys, 1, rank);
+    }
+    constexpr void ShrinkToFit() {
+      nodes_.ShrinkToFit();
+    }
+
+    template <class Compare>
+    [[nodiscard]] constexpr size_t LowerBound(const K* /*keys*/, size_t count, const K& key,
+                                              const Compare& comp) const {
+      size_t node = 1;
+      while (node <= count) {
+        node = 2 * node + (comp(nodes_[node].key, key) ? 1 : 0);
+      }
+      // The trailing ones are the right turns taken below the answer, the zero above them the
+      // left turn at it.
+      node >>= std::countr_one(node) + 1;
+      return node == 0 ? count : nodes_[node].rank;
+    }
+
+   private:
+    constexpr void BuildSubtree(const K* keys, size_t node, size_t& rank) noexcept {
+      if (node < nodes_.Size()) {
+        BuildSubtree(keys, 2 * node, rank);
+        nodes_[node].key = keys[rank];
+        nodes_[node].rank = rank++;
+        BuildSubtree(keys, 2 * node + 1, rank);
+      }
+    }
+
+    // The answer is a node on the search path, so keeping its rank next to its key saves a
+    // cache miss per lookup.
+    struct Node {
+      K key;
+      size_t rank;
+    };
+
+    Vector<Node> nodes_;
+  };
+};
+
+namespace flat_set_detail {
+
+// Drops all but the first of each run of equivalent keys from a sorted range.
+template <typename K, class Alloc, class Growth, class Compare>
+constexpr void EraseDuplicates(Vector<K, Alloc, Growth>& keys, const Compare& comp) {
+  const auto equivalent = [&](const K& lhs, const K& rhs) { return !comp(lhs, rhs); };
+  keys.Erase(std::unique(keys.begin(), keys.end(), equivalent), keys.end());
+}
+
+template <typename K, class Alloc, class Growth, class Compare>
+constexpr void SortUnique(Vector<K, Alloc, Growth>& keys, const Compare& comp) {
+  if (!std::is_sorted(keys.begin(), keys.end(), comp)) {
+    std::stable_sort(keys.begin(), keys.end(), comp);
+  }
+  EraseDuplicates(keys, comp);
+}
+
+}  // namespace flat_set_detail
+
+// Ordered set of unique keys, stored sorted in a Vector. Lookups search contiguous memory
+// instead of chasing tree nodes; inserting or erasing one key shifts the keys after it, so
+// batches should go through the range Insert or InsertSorted, which merge once.
+template <typename K, class Compare = std::less<K>, class Search = BinarySearch, class Allocator = std::allocator<K>>
+class FlatSet {
+ public:
+  using KeyType = K;
+  using ValueType = K;
+  using SizeType = size_t;
+  using ConstIterator = const K*;
+  using Iterator = ConstIterator;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+  using KeyContainer = Vector<K, Allocator>;
+
+  constexpr FlatSet() = default;
+  explicit constexpr FlatSet(const Compare& comp) : comp_(comp) {
+  }
+  // Sorts keys and drops duplicates, keeping the first of equivalent keys.
+  explicit constexpr FlatSet(KeyContainer keys, const Compare& comp = Compare())
+      : keys_(std::move(keys)), comp_(comp) {
+    flat_set_detail::SortUnique(keys_, comp_);
+    index_.Reserve(keys_.Size());
+    Reindex();
+  }
+  constexpr FlatSet(std::initializer_list<K> init_lst, const Compare& comp = Compare())
+      : FlatSet(KeyContainer(init_lst), comp) {
+  }
+  template <typename InputIterator>
+  constexpr FlatSet(InputIterator first, InputIterator last, const Compare& comp = Compare())
+      : FlatSet(KeyContainer(first, last), comp) {
+  }
+
+  [[nodiscard]] constexpr SizeType Size() const noexcept {
+    return keys_.Size();
+  }
+  [[nodiscard]] constexpr bool Empty() const noexcept {
+    return keys_.Empty();
+  }
+  [[nodiscard]] constexpr SizeType Capacity() const noexcept {
+    return keys_.Capacity();
+  }
+  [[nodiscard]] constexpr ConstVectorView<K> Keys() const noexcept {
+    return keys_;
+  }
+  [[nodiscard]] constexpr const Compare& KeyComp() const noexcept {
+    return comp_;
+  }
+
+  constexpr void Reserve(size_t capacity) {
+    index_.Reserve(capacity);
+    keys_.Reserve(capacity);
+  }
+  constexpr void ShrinkToFit() {
+    keys_.ShrinkToFit();
+    index_.ShrinkToFit();
+  }
+  constexpr void Clear() noexcept {
+    keys_.Clear();
+    Reindex();
+  }
+  // Hands the sorted keys over and leaves the set empty.
+  [[nodiscard]] constexpr KeyContainer Extract() noexcept {
+    KeyContainer keys(std::move(keys_));
+    Reindex();
+    return keys;
+  }
+
+  [[nodiscard]] constexpr ConstIterator LowerBound(const K& key) const {
+    return keys_.begin() + index_.LowerBound(keys_.Data(), keys_.Size(), key, comp_);
+  }
+  [[nodiscard]] constexpr ConstIterator UpperBound(const K& key) const {
+    return std::upper_bound(keys_.begin(), keys_.end(), key, comp_);
+  }
+  [[nodiscard]] constexpr ConstIterator Find(const K& key) const {
+    const auto found = LowerBound(key);
+    return found != end() && !comp_(key, *found) ? found : end();
+  }
+  [[nodiscard]] constexpr bool Contains(const K& key) const {
+    return Find(key) != end();
+  }
+  [[nodiscard]] constexpr SizeType Count(const K& key) const {
+    return Contains(key) ? 1 : 0;
+  }
+
+  constexpr std::pair<ConstIterator, bool> Insert(const K& key) {
+    return InsertAt(LowerBound(key), key);
+  }
+  constexpr std::pair<ConstIterator, bool> Insert(K&& key) {
+    return InsertAt(LowerBound(key), std::move(key));
+  }
+  // Sorts the new keys and merges them in once. Keys already in the set win over equivalent
+  // new ones.
+  template <typename InputIterator>
+  constexpr void Insert(InputIterator first, InputIterator last) {
+    MergeWith([&](size_t old_size) {
+      keys_.AppendFrom(first, last);
+      std::stable_sort(keys_.begin() + old_size, keys_.end(), comp_);
+    });
+  }
+  constexpr void Insert(std::initializer_list<K> init_lst) {
+    Insert(init_lst.begin(), init_lst.end());
+  }
+  // Like the range Insert, for keys already sorted by KeyComp().
+  template <typename InputIterator>
+  constexpr void InsertSorted(InputIterator first, InputIterator last) {
+    MergeWith([&](size_t /*old_size*/) { keys_.AppendFrom(first, last); });
+  }
+
+  constexpr ConstIterator Erase(ConstIterator pos) {
+    const auto next = keys_.Erase(pos);
+    Reindex();
+    return next;
+  }
+  constexpr ConstIterator Erase(ConstIterator first, ConstIterator last) {
+    const auto next = keys_.Erase(first, last);
+    Reindex();
+    return next;
+  }
+  constexpr SizeType Erase(const K& key) {
+    const auto found = Find(key);
+    if (found == end()) {
+      return 0;
+    }
+    Erase(found);
+    return 1;
+  }
+  template <class Predicate>
+  constexpr SizeType EraseIf(Predicate pred) {
+    const auto erased = ::EraseIf(keys_, pred);
+    Reindex();
+    return erased;
+  }
+
+  constexpr void Swap(FlatSet& other) noexcept {
+    keys_.Swap(other.keys_);
+    std::swap(comp_, other.comp_);
+    std::swap(index_, other.index_);
+  }
+
+  [[nodiscard]] constexpr ConstIterator begin() const noexcept {  // NOLINT
+    return keys_.begin();
+  }
+  [[nodiscard]] constexpr ConstIterator end() const noexcept {  // NOLINT
+    return keys_.end();
+  }
+  [[nodiscard]] constexpr ConstIterator cbegin() const noexcept {  // NOLINT
+    return keys_.cbegin();
+  }
+  [[nodiscard]] constexpr ConstIterator cend() const noexcept {  // NOLINT
+    return keys_.cend();
+  }
+  [[nodiscard]] constexpr ConstReverseIterator rbegin() const noexcept {  // NOLINT
+    return ConstReverseIterator(end());
+  }
+  [[nodiscard]] constexpr ConstReverseIterator rend() const noexcept {  // NOLINT
+    return ConstReverseIterator(begin());
+  }
+
+ private:
+  template <typename Key>
+  constexpr std::pair<ConstIterator, bool> InsertAt(ConstIterator pos, Key&& key) {
+    if (pos != end() && !comp_(key, *pos)) {
+      return {pos, false};
+    }
+    index_.Reserve(keys_.Size() + 1);
+    const auto inserted = keys_.Insert(pos, std::forward<Key>(key));
+    Reindex();
+    return {inserted, true};
+  }
+
+  // append(old_size) puts the new keys, sorted, after the old ones; on a throw they are dropped.
+  template <class Append>
+  constexpr void MergeWith(Append append) {
+    const size_t old_size = keys_.Size();
+    try {
+      append(old_size);
+      index_.Reserve(keys_.Size());
+    } catch (...) {
+      keys_.Erase(keys_.begin() + old_size, keys_.end());
+      throw;
+    }
+    if (old_size == keys_.Size()) {
+      return;
+    }
+    // On a throw here the keys are no longer sorted, so the set is cleared.
+    try {
+      std::inplace_merge(keys_.begin(), keys_.begin() + old_size, keys_.end(), comp_);
+    } catch (...) {
+      Clear();
+      throw;
+    }
+    flat_set_detail::EraseDuplicates(keys_, comp_);
+    Reindex();
+  }
+
+  constexpr void Reindex() noexcept {
+    index_.Build(keys_.Data(), keys_.Size());
+  }
+
+  KeyContainer keys_;
+  [[no_unique_address]] Compare comp_;
+  [[no_unique_address]] typename Search::template Index<K> index_;
+};
+
+template <typename K, class Compare, class Search, class Allocator>
+[[nodiscard]] constexpr bool operator==(const FlatSet<K, Compare, Search, Allocator>& lhs,
+                                        const FlatSet<K, Compare, Search, Allocator>& rhs) {
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename K, class Compare, class Search, class Allocator>
+[[nodiscard]] constexpr bool operator!=(const FlatSet<K, Compare, Search, Allocator>& lhs,
+                                        const FlatSet<K, Compare, Search, Allocator>& rhs) {
+  return !(lhs == rhs);
+}
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_FLAT_SET_H_
@@ -0,0 +1,596 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_INCREMENTAL_VECTOR_H_
+#define OOP_ASSIGNMENTS_VECTOR_INCREMENTAL_VECTOR_H_
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+#include "vector.h"
+
+// Contiguous vector whose reallocation is spread over the appends that follow it. When
+// EmplaceBack outgrows the buffer it allocates the new one and builds the new element there,
+// but leaves the old elements where they are; each later EmplaceBack relocates a bounded batch
+// of them, sized so that the migration is over before the new buffer fills up. Until then an
+// element is read from whichever buffer holds it, so every append costs O(MigrationStep)
+// relocations for any growth policy that at least doubles, and the buffer is contiguous again
+// once FinishMigration or Data has run. Operations on more than one element at a time finish
+// the migration first.
+template <typename T, class Allocator = std::allocator<T>, class GrowthPolicy = DoublingGrowth,
+          size_t MigrationStep = 32>
+class IncrementalVector {
+  static_assert(MigrationStep != 0, "MigrationStep must be positive");
+
+  using AllocTraits = std::allocator_traits<Allocator>;
+
+  template <bool kConst>
+  class BasicIterator;
+
+ public:
+  using ValueType = T;
+  using Pointer = T*;
+  using ConstPointer = const T*;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+  using Iterator = BasicIterator<false>;
+  using ConstIterator = BasicIterator<true>;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+  IncrementalVector() noexcept(noexcept(Allocator())) = default;
+  explicit IncrementalVector(const Allocator& alloc) noexcept : alloc_(alloc) {
+  }
+  explicit IncrementalVector(size_t size, const Allocator& alloc = Allocator()) : IncrementalVector(alloc) {
+    Resize(size);
+  }
+  IncrementalVector(size_t size, const T& value, const Allocator& alloc = Allocator()) : IncrementalVector(alloc) {
+    Resize(size, value);
+  }
+  IncrementalVector(std::initializer_list<T> init_lst, const Allocator& alloc = Allocator())
+      : IncrementalVector(alloc) {
+    Reserve(init_lst.size());
+    ElementOps::CopyIterTo(alloc_, init_lst.begin(), init_lst.end(), buffer_);
+    size_ = init_lst.size();
+  }
+  IncrementalVector(const IncrementalVector& other)
+      : IncrementalVector(AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+    Reserve(other.size_);
+    ElementOps::CopyIterTo(alloc_, other.begin(), other.end(), buffer_);
+    size_ = other.size_;
+  }
+  IncrementalVector(IncrementalVector&& other) noexcept : alloc_(other.alloc_) {
+    StealStorage(other);
+  }
+
+  IncrementalVector& operator=(const IncrementalVector& other) {
+    if (this != &other) {
+      IncrementalVector copy(other, kPropagateOnCopy ? other.alloc_ : alloc_);
+      Release();
+      if constexpr (kPropagateOnCopy) {
+        alloc_ = other.alloc_;
+      }
+      StealStorage(copy);
+    }
+    return *this;
+  }
+  // With unequal allocators that do not propagate, the elements are moved one by one into a
+  // buffer from this vector's allocator.
+  IncrementalVector& operator=(IncrementalVector&& other) noexcept(kPropagateOnMove ||
+                                                                    AllocTraits::is_always_equal::value) {
+    if (this != &other) {
+      if (kPropagateOnMove || alloc_ == other.alloc_) {
+        Release();
+        if constexpr (kPropagateOnMove) {
+          alloc_ = other.alloc_;
+        }
+        StealStorage(other);
+      } else {
+        IncrementalVector moved(alloc_);
+        moved.Reserve(other.size_);
+        ElementOps::CopyIterTo(alloc_, std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()),
+                               moved.buffer_);
+        moved.size_ = other.size_;
+        other.Clear();
+        Release();
+        StealStorage(moved);
+      }
+    }
+    return *this;
+  }
+
+  ~IncrementalVector() {
+    Release();
+  }
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return size_;
+  }
+  // Capacity of the new buffer while a migration is under way.
+  [[nodiscard]] SizeType Capacity() const noexcept {
+    return capacity_;
+  }
+  [[nodiscard]] bool Empty() const noexcept {
+    return size_ == 0;
+  }
+  [[nodiscard]] bool IsMigrating() const noexcept {
+    return old_ != nullptr;
+  }
+  [[nodiscard]] ConstReference Front() const noexcept {
+    return (*this)[0];
+  }
+  [[nodiscard]] Reference Front() noexcept {
+    return (*this)[0];
+  }
+  [[nodiscard]] ConstReference Back() const noexcept {
+    return (*this)[size_ - 1];
+  }
+  [[nodiscard]] Reference Back() noexcept {
+    return (*this)[size_ - 1];
+  }
+  [[nodiscard]] ConstReference At(size_t idx) const {
+    if (idx >= size_) {
+      throw std::out_of_range("");
+    }
+    return (*this)[idx];
+  }
+  [[nodiscard]] Reference At(size_t idx) {
+    if (idx >= size_) {
+      throw std::out_of_range("");
+    }
+    return (*this)[idx];
+  }
+  [[nodiscard]] ConstReference operator[](size_t idx) const noexcept {
+    return *Slot(idx);
+  }
+  [[nodiscard]] Reference operator[](size_t idx) noexcept {
+    return *Slot(idx);
+  }
+  // Finishes the migration, so that the elements are contiguous.
+  [[nodiscard]] Pointer Data() {
+    FinishMigration();
+    return buffer_;
+  }
+
+  [[nodiscard]] Allocator GetAllocator() const noexcept {
+    return alloc_;
+  }
+
+  // Relocates the elements still in the old buffer and frees it.
+  void FinishMigration() {
+    if (IsMigrating()) {
+      Migrate(old_size_ - migrated_);
+    }
+  }
+
+  // Allocators are only exchanged when they propagate on swap; otherwise they must compare equal.
+  void Swap(IncrementalVector& other) noexcept {
+    std::swap(buffer_, other.buffer_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(old_, other.old_);
+    std::swap(old_capacity_, other.old_capacity_);
+    std::swap(old_size_, other.old_size_);
+    std::swap(migrated_, other.migrated_);
+    std::swap(step_, other.step_);
+    if constexpr (AllocTraits::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
+  }
+  void Clear() noexcept {
+    Truncate(0);
+  }
+  void Resize(size_t size) {
+    ResizeWith(size, [&](Pointer gap, size_t count) { ElementOps::ValueInitTo(alloc_, gap, count); });
+  }
+  void Resize(size_t size, const T& value) {
+    if (size > size_ && IsOldElement(value)) {
+      T copy(value);
+      Resize(size, copy);
+      return;
+    }
+    ResizeWith(size, [&](Pointer gap, size_t count) { ElementOps::FillTo(alloc_, gap, count, value); });
+  }
+  void Reserve(size_t capacity) {
+    FinishMigration();
+    if (capacity > capacity_) {
+      Reallocate(capacity);
+    }
+  }
+  void ShrinkToFit() {
+    FinishMigration();
+    if (size_ == 0) {
+      DeallocateBuffer();
+      buffer_ = nullptr;
+      capacity_ = 0;
+    } else if (size_ != capacity_) {
+      Reallocate(size_);
+    }
+  }
+
+  // The arguments may refer to elements of this vector: the element is built before anything
+  // is relocated.
+  template <class... Args>
+  void EmplaceBack(Args&&... args) {
+    if (size_ == capacity_) {
+      Grow(std::forward<Args>(args)...);
+      return;
+    }
+    AllocTraits::construct(alloc_, buffer_ + size_, std::forward<Args>(args)...);
+    if (IsMigrating()) {
+      try {
+        Migrate(step_);
+      } catch (...) {
+        AllocTraits::destroy(alloc_, buffer_ + size_);
+        throw;
+      }
+    }
+    ++size_;
+  }
+  void PushBack(const T& value) {
+    EmplaceBack(value);
+  }
+  void PushBack(T&& value) {
+    EmplaceBack(std::move(value));
+  }
+  void PopBack() noexcept {
+    if (!Empty()) {
+      Truncate(size_ - 1);
+    }
+  }
+
+  template <class... Args>
+  Iterator EmplaceAt(ConstIterator pos, Args&&... args) {
+    const auto idx = static_cast<size_t>(pos - cbegin());
+    EmplaceBack(std::forward<Args>(args)...);
+    std::rotate(begin() + idx, end() - 1, end());
+    return begin() + idx;
+  }
+  Iterator Insert(ConstIterator pos, const T& value) {
+    return EmplaceAt(pos, value);
+  }
+  Iterator Insert(ConstIterator pos, T&& value) {
+    return EmplaceAt(pos, std::move(value));
+  }
+  Iterator Erase(ConstIterator pos) {
+    return Erase(pos, pos + 1);
+  }
+  // Basic guarantee if a move assignment throws.
+  Iterator Erase(ConstIterator first, ConstIterator last) {
+    const auto idx = static_cast<size_t>(first - cbegin());
+    const auto count = static_cast<size_t>(last - first);
+    if (count != 0) {
+      std::move(begin() + idx + count, end(), begin() + idx);
+      Truncate(size_ - count);
+    }
+    return begin() + idx;
+  }
+
+  // Contiguous copy of the elements.
+  template <class Growth = GrowthPolicy>
+  [[nodiscard]] Vector<T, Allocator, Growth> ToVector() const {
+    Vector<T, Allocator, Growth> result(AllocTraits::select_on_container_copy_construction(alloc_));
+    result.Reserve(size_);
+    result.AppendRange(begin(), end());
+    return result;
+  }
+
+  [[nodiscard]] ConstIterator cbegin() const noexcept {  // NOLINT
+    return ConstIterator(this, 0);
+  }
+  [[nodiscard]] ConstIterator begin() const noexcept {  // NOLINT
+    return cbegin();
+  }
+  [[nodiscard]] Iterator begin() noexcept {  // NOLINT
+    return Iterator(this, 0);
+  }
+  [[nodiscard]] ConstIterator cend() const noexcept {  // NOLINT
+    return ConstIterator(this, size_);
+  }
+  [[nodiscard]] ConstIterator end() const noexcept {  // NOLINT
+    return cend();
+  }
+  [[nodiscard]] Iterator end() noexcept {  // NOLINT
+    return Iterator(this, size_);
+  }
+  [[nodiscard]] ConstReverseIterator crbegin() const noexcept {  // NOLINT
+    return ConstReverseIterator(cend());
+  }
+  [[nodiscard]] ConstReverseIterator rbegin() const noexcept {  // NOLINT
+    return crbegin();
+  }
+  [[nodiscard]] ReverseIterator rbegin() noexcept {  // NOLINT
+    return ReverseIterator(end());
+  }
+  [[nodiscard]] ConstReverseIterator crend() const noexcept {  // NOLINT
+    return ConstReverseIterator(cbegin());
+  }
+  [[nodiscard]] ConstReverseIterator rend() const noexcept {  // NOLINT
+    return crend();
+  }
+  [[nodiscard]] ReverseIterator rend() noexcept {  // NOLINT
+    return ReverseIterator(begin());
+  }
+
+ private:
+  using ElementOps = vector_detail::ElementOps<T, Allocator>;
+
+  static constexpr bool kPropagateOnCopy = AllocTraits::propagate_on_container_copy_assignment::value;
+  static constexpr bool kPropagateOnMove = AllocTraits::propagate_on_container_move_assignment::value;
+
+  // Index-based, so that it stays valid across a migration step.
+  template <bool kConst>
+  class BasicIterator {
+    using Owner = std::conditional_t<kConst, const IncrementalVector, IncrementalVector>;
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;  // NOLINT
+    using value_type = T;  // NOLINT
+    using difference_type = ptrdiff_t;  // NOLINT
+    using pointer = std::conditional_t<kConst, const T*, T*>;  // NOLINT
+    using reference = std::conditional_t<kConst, const T&, T&>;  // NOLINT
+
+    BasicIterator() noexcept = default;
+    template <bool kOtherConst, typename = std::enable_if_t<kConst && !kOtherConst>>
+    BasicIterator(const BasicIterator<kOtherConst>& other) noexcept  // NOLINT
+        : owner_(other.owner_), idx_(other.idx_) {
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {
+      return (*owner_)[idx_];
+    }
+    [[nodiscard]] pointer operator->() const noexcept {
+      return std::addressof((*owner_)[idx_]);
+    }
+    [[nodiscard]] reference operator[](difference_type n) const noexcept {
+      return (*owner_)[idx_ + n];
+    }
+
+    BasicIterator& operator++() noexcept {
+      ++idx_;
+      return *this;
+    }
+    BasicIterator operator++(int) noexcept {
+      auto copy = *this;
+      ++idx_;
+      return copy;
+    }
+    BasicIterator& operator--() noexcept {
+      --idx_;
+      return *this;
+    }
+    BasicIterator operator--(int) noexcept {
+      auto copy = *this;
+      --idx_;
+      return copy;
+    }
+    BasicIterator& operator+=(difference_type n) noexcept {
+      idx_ += n;
+      return *this;
+    }
+    BasicIterator& operator-=(difference_type n) noexcept {
+      idx_ -= n;
+      return *this;
+    }
+    [[nodiscard]] friend BasicIterator operator+(BasicIterator it, difference_type n) noexcept {
+      return it += n;
+    }
+    [[nodiscard]] friend BasicIterator operator+(difference_type n, BasicIterator it) noexcept {
+      return it += n;
+    }
+    [[nodiscard]] friend BasicIterator operator-(BasicIterator it, difference_type n) noexcept {
+      return it -= n;
+    }
+    [[nodiscard]] friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return static_cast<difference_type>(lhs.idx_ - rhs.idx_);
+    }
+
+    [[nodiscard]] friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return lhs.idx_ == rhs.idx_;
+    }
+    [[nodiscard]] friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return lhs.idx_ != rhs.idx_;
+    }
+    [[nodiscard]] friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return lhs.idx_ < rhs.idx_;
+    }
+    [[nodiscard]] friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return rhs < lhs;
+    }
+    [[nodiscard]] friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return !(rhs < lhs);
+    }
+    [[nodiscard]] friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return !(lhs < rhs);
+    }
+
+   private:
+    friend class IncrementalVector;
+    template <bool>
+    friend class BasicIterator;
+
+    BasicIterator(Owner* owner, size_t idx) noexcept : owner_(owner), idx_(idx) {
+    }
+
+    Owner* owner_{nullptr};
+    size_t idx_{0};
+  };
+
+  IncrementalVector(const IncrementalVector& other, const Allocator& alloc) : IncrementalVector(alloc) {
+    Reserve(other.size_);
+    ElementOps::CopyIterTo(alloc_, other.begin(), other.end(), buffer_);
+    size_ = other.size_;
+  }
+
+  // Elements [migrated_, old_size_) are still in old_; all others are in buffer_. Without a
+  // migration both bounds are zero and the single unsigned comparison fails.
+  [[nodiscard]] T* Slot(size_t idx) const noexcept {
+    return idx - migrated_ < old_size_ - migrated_ ? old_ + idx : buffer_ + idx;
+  }
+
+  [[nodiscard]] bool IsOldElement(const T& value) const noexcept {
+    return IsMigrating() && std::less_equal<ConstPointer>()(old_, std::addressof(value)) &&
+           std::less<ConstPointer>()(std::addressof(value), old_ + old_size_);
+  }
+
+  // The new element goes straight into the new buffer while the old one is still intact, so
+  // args may refer to old elements. The step is picked so that the remaining free slots of
+  // the new buffer suffice to drain the old one; a growth policy that leaves none relocates
+  // everything right away.
+  template <class... Args>
+  void Grow(Args&&... args) {
+    auto [new_buff, new_capacity] = vector_detail::AllocateAtLeast(alloc_, GrowCapacity(size_ + 1));
+    try {
+      AllocTraits::construct(alloc_, new_buff + size_, std::forward<Args>(args)...);
+    } catch (...) {
+      AllocTraits::deallocate(alloc_, new_buff, new_capacity);
+      throw;
+    }
+    const size_t appends = new_capacity - size_ - 1;
+    if (size_ == 0 || appends == 0) {
+      try {
+        ElementOps::RelocateTo(alloc_, buffer_, size_, new_buff);
+      } catch (...) {
+        AllocTraits::destroy(alloc_, new_buff + size_);
+        AllocTraits::deallocate(alloc_, new_buff, new_capacity);
+        throw;
+      }
+      DeallocateBuffer();
+    } else {
+      old_ = buffer_;
+      old_capacity_ = capacity_;
+      old_size_ = size_;
+      migrated_ = 0;
+      step_ = std::max(MigrationStep, (size_ + appends - 1) / appends);
+    }
+    buffer_ = new_buff;
+    capacity_ = new_capacity;
+    ++size_;
+  }
+
+  // Relocates up to count of the elements left in the old buffer, in index order; the old
+  // buffer is freed once it is empty. Strong guarantee.
+  void Migrate(size_t count) {
+    count = std::min(count, old_size_ - migrated_);
+    ElementOps::RelocateTo(alloc_, old_ + migrated_, count, buffer_ + migrated_);
+    migrated_ += count;
+    if (migrated_ == old_size_) {
+      ReleaseOld();
+    }
+  }
+
+  void ReleaseOld() noexcept {
+    AllocTraits::deallocate(alloc_, old_, old_capacity_);
+    old_ = nullptr;
+    old_capacity_ = 0;
+    old_size_ = 0;
+    migrated_ = 0;
+  }
+
+  [[nodiscard]] size_t GrowCapacity(size_t required) const {
+    return vector_detail::GrowCapacity<GrowthPolicy, T>(alloc_, capacity_, required);
+  }
+
+  // Moves the contiguous elements into a buffer of at least `capacity` slots, after
+  // build(new_buff + size_) has constructed the elements that follow them, if any.
+  template <class Builder>
+  void Reallocate(size_t capacity, Builder&& build) {
+    auto [new_buff, new_capacity] = vector_detail::AllocateAtLeast(alloc_, capacity);
+    size_t built = 0;
+    try {
+      built = build(new_buff + size_);
+      ElementOps::RelocateTo(alloc_, buffer_, size_, new_buff);
+    } catch (...) {
+      ElementOps::Destroy(alloc_, new_buff + size_, built);
+      AllocTraits::deallocate(alloc_, new_buff, new_capacity);
+      throw;
+    }
+    DeallocateBuffer();
+    buffer_ = new_buff;
+    capacity_ = new_capacity;
+    size_ += built;
+  }
+  void Reallocate(size_t capacity) {
+    Reallocate(capacity, [](Pointer) { return size_t{0}; });
+  }
+
+  // Destroys the elements from position size onwards; elements popped out of the old buffer
+  // shorten what is left to migrate.
+  void Truncate(size_t size) noexcept {
+    while (size_ > size) {
+      --size_;
+      AllocTraits::destroy(alloc_, Slot(size_));
+    }
+    if (IsMigrating() && size_ < old_size_) {
+      old_size_ = std::max(size_, migrated_);
+      if (migrated_ == old_size_) {
+        ReleaseOld();
+      }
+    }
+  }
+
+  template <class Builder>
+  void ResizeWith(size_t size, Builder&& build) {
+    FinishMigration();
+    if (size <= size_) {
+      Truncate(size);
+      return;
+    }
+    const size_t count = size - size_;
+    if (size > capacity_) {
+      Reallocate(GrowCapacity(size), [&](Pointer gap) {
+        build(gap, count);
+        return count;
+      });
+    } else {
+      build(buffer_ + size_, count);
+      size_ = size;
+    }
+  }
+
+  void DeallocateBuffer() noexcept {
+    if (buffer_ != nullptr) {
+      AllocTraits::deallocate(alloc_, buffer_, capacity_);
+    }
+  }
+
+  void Release() noexcept {
+    Truncate(0);
+    DeallocateBuffer();
+    buffer_ = nullptr;
+    capacity_ = 0;
+  }
+
+  void StealStorage(IncrementalVector& other) noexcept {
+    buffer_ = std::exchange(other.buffer_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    capacity_ = std::exchange(other.capacity_, 0);
+    old_ = std::exchange(other.old_, nullptr);
+    old_capacity_ = std::exchange(other.old_capacity_, 0);
+    old_size_ = std::exchange(other.old_size_, 0);
+    migrated_ = std::exchange(other.migrated_, 0);
+    step_ = other.step_;
+  }
+
+  Allocator alloc_{Allocator{}};
+  T* buffer_{nullptr};
+  size_t size_{0};
+  size_t capacity_{0};
+  T* old_{nullptr};
+  size_t old_capacity_{0};
+  size_t old_size_{0};
+  size_t migrated_{0};
+  size_t step_{MigrationStep};
+};
+
+template <typename T, class Alloc, class Growth, size_t Step>
+[[nodiscard]] bool operator==(const IncrementalVector<T, Alloc, Growth, Step>& lhs,
+                              const IncrementalVector<T, Alloc, Growth, Step>& rhs) {
+  return lhs.Size() == rhs.Size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, class Alloc, class Growth, size_t Step>
+[[nodiscard]] bool operator!=(const IncrementalVector<T, Alloc, Growth, Step>& lhs,
+                              const IncrementalVector<T, Alloc, Growth, Step>& rhs) {
+  return !(lhs == rhs);
+}
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_INCREMENTAL_VECTOR_H_
@@ -0,0 +1,165 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_MALLOC_ALLOCATOR_H_
+#define OOP_ASSIGNMENTS_VECTOR_MALLOC_ALLOCATOR_H_
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#include <malloc.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "vector.h"
+
+// Allocator backed by malloc/realloc that implements Vector's try_expand and reallocate hooks.
+// On Linux, blocks of at least kMmapThreshold bytes are mapped directly and resized with
+// mremap, so growing a huge buffer only updates page tables instead of copying it.
+template <typename T>
+class MallocAllocator {
+  static_assert(alignof(T) <= alignof(std::max_align_t), "malloc does not over-align");
+
+ public:
+  using value_type = T;  // NOLINT
+  using is_always_equal = std::true_type;  // NOLINT
+  using propagate_on_container_move_assignment = std::true_type;  // NOLINT
+
+  static constexpr size_t kMmapThreshold = size_t{1} << 20;
+
+  struct AllocationResult {
+    T* ptr;
+    size_t count;
+  };
+
+  MallocAllocator() noexcept = default;
+  template <typename U>
+  MallocAllocator(const MallocAllocator<U>& /*other*/) noexcept {  // NOLINT
+  }
+
+  [[nodiscard]] T* allocate(size_t count) {  // NOLINT
+    return allocate_at_least(count).ptr;
+  }
+
+  [[nodiscard]] AllocationResult allocate_at_least(size_t count) {  // NOLINT
+    if (count > static_cast<size_t>(-1) / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    const size_t bytes = Bytes(count);
+    if (IsMapped(bytes)) {
+      const size_t mapped = RoundToPage(bytes);
+      // The rest of the last page is only reported when deallocate will round back to it.
+      return {static_cast<T*>(Map(mapped)), mapped % sizeof(T) == 0 ? mapped / sizeof(T) : count};
+    }
+    void* ptr = std::malloc(bytes);
+    if (ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+#if defined(__linux__)
+    // Keep the small-block class of the real size, so that deallocate still sees malloc memory.
+    const size_t usable = std::min(malloc_usable_size(ptr), kMmapThreshold - 1);
+    return {static_cast<T*>(ptr), usable / sizeof(T)};
+#else
+    return {static_cast<T*>(ptr), count};
+#endif
+  }
+
+  void deallocate(T* ptr, size_t count) noexcept {  // NOLINT
+    const size_t bytes = Bytes(count);
+    if (IsMapped(bytes)) {
+      Unmap(ptr, RoundToPage(bytes));
+    } else {
+      std::free(ptr);
+    }
+  }
+
+  // Succeeds only if the mapping can be extended where it is.
+  bool try_expand(T* ptr, size_t old_count, size_t new_count) noexcept {  // NOLINT
+#if defined(__linux__)
+    const size_t old_bytes = Bytes(old_count);
+    if (IsMapped(old_bytes) && new_count <= static_cast<size_t>(-1) / sizeof(T)) {
+      return mremap(ptr, RoundToPage(old_bytes), RoundToPage(Bytes(new_count)), 0) != MAP_FAILED;
+    }
+#else
+    static_cast<void>(ptr);
+    static_cast<void>(old_count);
+    static_cast<void>(new_count);
+#endif
+    return false;
+  }
+
+  // Moves the bytes when it has to; returns nullptr and keeps the old block on failure.
+  [[nodiscard]] T* reallocate(T* ptr, size_t old_count, size_t new_count) noexcept {  // NOLINT
+    const size_t old_bytes = Bytes(old_count);
+    const size_t new_bytes = Bytes(new_count);
+    if (!IsMapped(old_bytes) && !IsMapped(new_bytes)) {
+      return static_cast<T*>(std::realloc(ptr, new_bytes));
+    }
+#if defined(__linux__)
+    if (IsMapped(old_bytes) && IsMapped(new_bytes)) {
+      void* moved = mremap(ptr, RoundToPage(old_bytes), RoundToPage(new_bytes), MREMAP_MAYMOVE);
+      return moved == MAP_FAILED ? nullptr : static_cast<T*>(moved);
+    }
+#endif
+    T* new_ptr = nullptr;
+    try {
+      new_ptr = allocate(new_count);
+    } catch (const std::bad_alloc&) {
+      return nullptr;
+    }
+    std::memcpy(static_cast<void*>(new_ptr), static_cast<const void*>(ptr), std::min(old_bytes, new_bytes));
+    deallocate(ptr, old_count);
+    return new_ptr;
+  }
+
+ private:
+  [[nodiscard]] static size_t Bytes(size_t count) noexcept {
+    return count * sizeof(T);
+  }
+
+#if defined(__linux__)
+  [[nodiscard]] static bool IsMapped(size_t bytes) noexcept {
+    return bytes >= kMmapThreshold;
+  }
+  [[nodiscard]] static size_t RoundToPage(size_t bytes) noexcept {
+    static const auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return (bytes + page - 1) / page * page;
+  }
+  [[nodiscard]] static void* Map(size_t bytes) {
+    void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    return ptr;
+  }
+  static void Unmap(void* ptr, size_t bytes) noexcept {
+    munmap(ptr, bytes);
+  }
+#else
+  [[nodiscard]] static bool IsMapped(size_t /*bytes*/) noexcept {
+    return false;
+  }
+  [[nodiscard]] static size_t RoundToPage(size_t bytes) noexcept {
+    return bytes;
+  }
+  [[nodiscard]] static void* Map(size_t /*bytes*/) {
+    throw std::bad_alloc();
+  }
+  static void Unmap(void* /*ptr*/, size_t /*bytes*/) noexcept {
+  }
+#endif
+};
+
+template <typename T, typename U>
+[[nodiscard]] bool operator==(const MallocAllocator<T>& /*lhs*/, const MallocAllocator<U>& /*rhs*/) noexcept {
+  return true;
+}
+
+template <typename T, typename U>
+[[nodiscard]] bool operator!=(const MallocAllocator<T>& /*lhs*/, const MallocAllocator<U>& /*rhs*/) noexcept {
+  return false;
+}
+
+template <typename T>
+struct AllowsTrivialRelocation<MallocAllocator<T>> : std::true_type {};
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_MALLOC_ALLOCATOR_H_
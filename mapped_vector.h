@@ -0,0 +1,341 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_MAPPED_VECTOR_H_
+#define OOP_ASSIGNMENTS_VECTOR_MAPPED_VECTOR_H_
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "vector_io.h"
+
+enum class MapMode {
+  kCreate,    // create or truncate the file
+  kOpen,      // open an existing file for reading and writing
+  // Map an existing snapshot without copying it. Mutators throw std::logic_error before
+  // touching the mapping; writes through element references fault, as the pages are PROT_READ.
+  kReadOnly,
+};
+
+// Vector of trivially copyable elements stored in a shared mapping of a file. The element count
+// lives in the mapped header, so the file is a valid snapshot at any point; Sync flushes it to
+// disk. Growth extends the file and remaps it, which invalidates pointers like reallocation.
+template <typename T, class GrowthPolicy = DoublingGrowth>
+class MappedVector {
+  static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can be mapped");
+  static_assert(alignof(T) <= VectorFileHeader::kPayloadOffset, "over-aligned types are not supported");
+
+ public:
+  using ValueType = T;
+  using Pointer = T*;
+  using ConstPointer = const T*;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+  using Iterator = Pointer;
+  using ConstIterator = ConstPointer;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+  explicit MappedVector(const std::string& path, MapMode mode = MapMode::kOpen) : read_only_(mode == MapMode::kReadOnly) {
+    const int flags = read_only_ ? O_RDONLY : (mode == MapMode::kCreate ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR);
+    fd_ = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+      throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+    try {
+      if (mode == MapMode::kCreate) {
+        Truncate(VectorFileHeader::kPayloadOffset);
+        Map(VectorFileHeader::kPayloadOffset);
+        InitHeader();
+      } else {
+        struct stat info {};
+        if (::fstat(fd_, &info) != 0) {
+          throw std::system_error(errno, std::generic_category(), "fstat " + path);
+        }
+        const auto file_size = static_cast<size_t>(info.st_size);
+        if (file_size < VectorFileHeader::kPayloadOffset) {
+          throw std::runtime_error("not a vector file: " + path);
+        }
+        Map(file_size);
+        CheckHeader(file_size);
+      }
+    } catch (...) {
+      Unmap();
+      ::close(fd_);
+      throw;
+    }
+  }
+
+  MappedVector(const MappedVector&) = delete;
+  MappedVector& operator=(const MappedVector&) = delete;
+
+  MappedVector(MappedVector&& other) noexcept
+      : fd_(std::exchange(other.fd_, -1))
+      , map_(std::exchange(other.map_, nullptr))
+      , mapped_bytes_(std::exchange(other.mapped_bytes_, 0))
+      , capacity_(std::exchange(other.capacity_, 0))
+      , read_only_(other.read_only_) {
+  }
+  MappedVector& operator=(MappedVector&& other) noexcept {
+    if (this != &other) {
+      MappedVector(std::move(other)).Swap(*this);
+    }
+    return *this;
+  }
+
+  ~MappedVector() {
+    Unmap();
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return map_ == nullptr ? 0 : static_cast<size_t>(Header()->count);
+  }
+  [[nodiscard]] SizeType Capacity() const noexcept {
+    return capacity_;
+  }
+  [[nodiscard]] bool Empty() const noexcept {
+    return Size() == 0;
+  }
+  [[nodiscard]] bool IsReadOnly() const noexcept {
+    return read_only_;
+  }
+  [[nodiscard]] ConstReference Front() const noexcept {
+    return Data()[0];
+  }
+  [[nodiscard]] Reference Front() noexcept {
+    return Data()[0];
+  }
+  [[nodiscard]] ConstReference Back() const noexcept {
+    return Data()[Size() - 1];
+  }
+  [[nodiscard]] Reference Back() noexcept {
+    return Data()[Size() - 1];
+  }
+  [[nodiscard]] ConstReference At(size_t idx) const {
+    if (idx >= Size()) {
+      throw std::out_of_range("");
+    }
+    return Data()[idx];
+  }
+  [[nodiscard]] Reference At(size_t idx) {
+    return const_cast<T&>(const_cast<const MappedVector&>(*this).At(idx));
+  }
+  [[nodiscard]] ConstPointer Data() const noexcept {
+    return map_ == nullptr ? nullptr : reinterpret_cast<ConstPointer>(map_ + VectorFileHeader::kPayloadOffset);
+  }
+  [[nodiscard]] Pointer Data() noexcept {
+    return const_cast<Pointer>(const_cast<const MappedVector&>(*this).Data());
+  }
+  [[nodiscard]] ConstReference operator[](size_t idx) const noexcept {
+    return Data()[idx];
+  }
+  [[nodiscard]] Reference operator[](size_t idx) noexcept {
+    return Data()[idx];
+  }
+
+  void Swap(MappedVector& other) noexcept {
+    std::swap(fd_, other.fd_);
+    std::swap(map_, other.map_);
+    std::swap(mapped_bytes_, other.mapped_bytes_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(read_only_, other.read_only_);
+  }
+  void Clear() {
+    SetSize(0);
+  }
+  void Resize(size_t size, const T& value = T()) {
+    CheckWritable();
+    if (size > capacity_) {
+      const T copy = value;
+      Reserve(GrowCapacity(size));
+      std::uninitialized_fill(Data() + Size(), Data() + size, copy);
+    } else if (size > Size()) {
+      std::uninitialized_fill(Data() + Size(), Data() + size, value);
+    }
+    SetSize(size);
+  }
+  void Reserve(size_t capacity) {
+    CheckWritable();
+    if (capacity_ < capacity) {
+      Remap(capacity);
+    }
+  }
+  // Truncates the file to the current size.
+  void ShrinkToFit() {
+    CheckWritable();
+    if (Size() != capacity_) {
+      Remap(Size());
+    }
+  }
+
+  template <class... Args>
+  void EmplaceBack(Args&&... args) {
+    CheckWritable();
+    const size_t size = Size();
+    if (size == capacity_) {
+      const T value(std::forward<Args>(args)...);
+      Reserve(GrowCapacity(size + 1));
+      ::new (static_cast<void*>(Data() + size)) T(value);
+    } else {
+      ::new (static_cast<void*>(Data() + size)) T(std::forward<Args>(args)...);
+    }
+    Header()->count = size + 1;
+  }
+  void PushBack(const T& value) {
+    EmplaceBack(value);
+  }
+  void PopBack() {
+    CheckWritable();
+    if (!Empty()) {
+      SetSize(Size() - 1);
+    }
+  }
+
+  // Flushes the mapped pages and the header to the file.
+  void Sync() {
+    if (map_ != nullptr && !read_only_ && ::msync(map_, mapped_bytes_, MS_SYNC) != 0) {
+      throw std::system_error(errno, std::generic_category(), "msync");
+    }
+  }
+
+  [[nodiscard]] ConstIterator cbegin() const noexcept {  // NOLINT
+    return Data();
+  }
+  [[nodiscard]] ConstIterator begin() const noexcept {  // NOLINT
+    return cbegin();
+  }
+  [[nodiscard]] Iterator begin() noexcept {  // NOLINT
+    return Data();
+  }
+  [[nodiscard]] ConstIterator cend() const noexcept {  // NOLINT
+    return Data() + Size();
+  }
+  [[nodiscard]] ConstIterator end() const noexcept {  // NOLINT
+    return cend();
+  }
+  [[nodiscard]] Iterator end() noexcept {  // NOLINT
+    return Data() + Size();
+  }
+  [[nodiscard]] ConstReverseIterator crbegin() const noexcept {  // NOLINT
+    return ConstReverseIterator(cend());
+  }
+  [[nodiscard]] ConstReverseIterator rbegin() const noexcept {  // NOLINT
+    return crbegin();
+  }
+  [[nodiscard]] ReverseIterator rbegin() noexcept {  // NOLINT
+    return ReverseIterator(end());
+  }
+  [[nodiscard]] ConstReverseIterator crend() const noexcept {  // NOLINT
+    return ConstReverseIterator(cbegin());
+  }
+  [[nodiscard]] ConstReverseIterator rend() const noexcept {  // NOLINT
+    return crend();
+  }
+  [[nodiscard]] ReverseIterator rend() noexcept {  // NOLINT
+    return ReverseIterator(begin());
+  }
+
+ private:
+  [[nodiscard]] const VectorFileHeader* Header() const noexcept {
+    return reinterpret_cast<const VectorFileHeader*>(map_);
+  }
+  [[nodiscard]] VectorFileHeader* Header() noexcept {
+    return reinterpret_cast<VectorFileHeader*>(map_);
+  }
+
+  [[nodiscard]] size_t GrowCapacity(size_t required) const {
+    const size_t max_size = (static_cast<size_t>(-1) - VectorFileHeader::kPayloadOffset) / sizeof(T);
+    if (required > max_size) {
+      throw std::length_error("");
+    }
+    return std::min(GrowthPolicy::NextCapacity(capacity_, required, sizeof(T)), max_size);
+  }
+
+  void CheckWritable() const {
+    if (read_only_) {
+      throw std::logic_error("MappedVector is read-only");
+    }
+  }
+
+  void SetSize(size_t size) {
+    CheckWritable();
+    Header()->count = size;
+  }
+
+  void InitHeader() noexcept {
+    const auto header = vector_io_detail::MakeHeader<T>(0, 0);
+    std::memcpy(map_, header.bytes, sizeof(header.bytes));
+  }
+
+  void CheckHeader(size_t file_size) {
+    const auto header = vector_io_detail::CheckHeader<T>(map_, 0);
+    capacity_ = (file_size - VectorFileHeader::kPayloadOffset) / sizeof(T);
+    if (header.count > capacity_) {
+      throw std::runtime_error("vector file is truncated");
+    }
+  }
+
+  void Truncate(size_t bytes) {
+    if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+      throw std::system_error(errno, std::generic_category(), "ftruncate");
+    }
+  }
+
+  void Map(size_t bytes) {
+    const int prot = read_only_ ? PROT_READ : PROT_READ | PROT_WRITE;
+    void* map = ::mmap(nullptr, bytes, prot, MAP_SHARED, fd_, 0);
+    if (map == MAP_FAILED) {
+      throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+    map_ = static_cast<char*>(map);
+    mapped_bytes_ = bytes;
+  }
+
+  void Unmap() noexcept {
+    if (map_ != nullptr) {
+      ::munmap(map_, mapped_bytes_);
+      map_ = nullptr;
+      mapped_bytes_ = 0;
+    }
+  }
+
+  // Sets the file to hold exactly `capacity` elements and maps all of it.
+  void Remap(size_t capacity) {
+    CheckWritable();
+    const size_t bytes = VectorFileHeader::kPayloadOffset + capacity * sizeof(T);
+    const bool grows = bytes > mapped_bytes_;
+    if (grows) {
+      Truncate(bytes);
+    }
+#if defined(__linux__)
+    void* map = ::mremap(map_, mapped_bytes_, bytes, MREMAP_MAYMOVE);
+    if (map == MAP_FAILED) {
+      throw std::system_error(errno, std::generic_category(), "mremap");
+    }
+    map_ = static_cast<char*>(map);
+    mapped_bytes_ = bytes;
+#else
+    Unmap();
+    Map(bytes);
+#endif
+    if (!grows) {
+      Truncate(bytes);
+    }
+    capacity_ = capacity;
+  }
+
+  int fd_{-1};
+  char* map_{nullptr};
+  size_t mapped_bytes_{0};
+  size_t capacity_{0};
+  bool read_only_;
+};
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_MAPPED_VECTOR_H_
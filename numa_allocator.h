@@ -0,0 +1,204 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_NUMA_ALLOCATOR_H_
+#define OOP_ASSIGNMENTS_VECTOR_NUMA_ALLOCATOR_H_
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <new>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "thread_pool.h"
+#include "vector.h"
+#include "vector_parallel.h"
+
+// Where the pages of a NumaAllocator block come from.
+enum class NumaPolicy {
+  // The kernel default: each page goes to the node of the thread that first writes it, so the
+  // workers that build a partition (see MakeNumaVector) get it local.
+  kFirstTouch,
+  // Pages round-robin over the nodes this process may use, for data every node scans.
+  kInterleave,
+  // Pages only from one node.
+  kBind,
+};
+
+namespace numa_allocator_detail {
+
+inline constexpr size_t kMaxNodes = 1024;
+
+using NodeMask = std::array<unsigned long, kMaxNodes / (8 * sizeof(unsigned long))>;  // NOLINT
+
+#if defined(__linux__)
+
+// Both syscalls take the mask length in bits plus one.
+inline constexpr unsigned long kMaskBits = kMaxNodes + 1;  // NOLINT
+
+// Node 0 alone if the kernel has no NUMA support.
+[[nodiscard]] inline const NodeMask& AllowedNodes() noexcept {
+  static const NodeMask allowed = [] {
+    NodeMask nodes{};
+    if (syscall(SYS_get_mempolicy, nullptr, nodes.data(), kMaskBits, nullptr, MPOL_F_MEMS_ALLOWED) != 0) {
+      nodes = {};
+      nodes[0] = 1;
+    }
+    return nodes;
+  }();
+  return allowed;
+}
+
+// Placement is a hint: where mbind fails (no NUMA support, no such node) the block keeps the
+// default first-touch policy.
+inline void Place(void* ptr, size_t bytes, NumaPolicy policy, int node) noexcept {
+  if (policy == NumaPolicy::kInterleave) {
+    static_cast<void>(syscall(SYS_mbind, ptr, bytes, MPOL_INTERLEAVE, AllowedNodes().data(), kMaskBits, 0));
+  } else if (policy == NumaPolicy::kBind && node >= 0 && static_cast<size_t>(node) < kMaxNodes) {
+    NodeMask nodes{};
+    constexpr size_t kWordBits = 8 * sizeof(unsigned long);  // NOLINT
+    nodes[static_cast<size_t>(node) / kWordBits] = 1UL << (static_cast<size_t>(node) % kWordBits);
+    static_cast<void>(syscall(SYS_mbind, ptr, bytes, MPOL_BIND, nodes.data(), kMaskBits, 0));
+  }
+}
+
+[[nodiscard]] inline size_t PageSize() noexcept {
+  static const auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page;
+}
+
+#endif  // __linux__
+
+}  // namespace numa_allocator_detail
+
+// Number of NUMA nodes this process may allocate from; 1 without NUMA support.
+[[nodiscard]] inline size_t NumaNodeCount() noexcept {
+#if defined(__linux__)
+  size_t count = 0;
+  for (const auto word : numa_allocator_detail::AllowedNodes()) {
+    count += static_cast<size_t>(std::popcount(word));
+  }
+  return count;
+#else
+  return 1;
+#endif
+}
+
+// Allocator whose blocks of at least kMapThreshold bytes are fresh anonymous mappings placed
+// by a NumaPolicy with mbind before any page is touched. Smaller blocks come from operator new,
+// where placement is not worth a mapping. Any NumaAllocator frees any block, so they compare
+// equal, and the policy travels with the buffer on copy, move and swap. Elsewhere than Linux
+// every block comes from operator new.
+template <typename T>
+class NumaAllocator {
+  static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "NumaAllocator blocks are not over-aligned");
+
+ public:
+  using value_type = T;  // NOLINT
+  using is_always_equal = std::true_type;  // NOLINT
+  using propagate_on_container_copy_assignment = std::true_type;  // NOLINT
+  using propagate_on_container_move_assignment = std::true_type;  // NOLINT
+  using propagate_on_container_swap = std::true_type;  // NOLINT
+
+  static constexpr size_t kMapThreshold = size_t{1} << 20;
+
+  struct AllocationResult {
+    T* ptr;
+    size_t count;
+  };
+
+  NumaAllocator() noexcept = default;
+  // node is only used by NumaPolicy::kBind.
+  explicit NumaAllocator(NumaPolicy policy, int node = 0) noexcept : policy_(policy), node_(node) {
+  }
+  template <typename U>
+  NumaAllocator(const NumaAllocator<U>& other) noexcept  // NOLINT
+      : policy_(other.Policy()), node_(other.Node()) {
+  }
+
+  [[nodiscard]] T* allocate(size_t count) {  // NOLINT
+    return allocate_at_least(count).ptr;
+  }
+
+  // Mapped blocks report the whole of their last page; deallocate rounds back to it.
+  [[nodiscard]] AllocationResult allocate_at_least(size_t count) {  // NOLINT
+    if (count > (static_cast<size_t>(-1) / 2) / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    const size_t bytes = count * sizeof(T);
+#if defined(__linux__)
+    if (bytes >= kMapThreshold) {
+      const size_t mapped = RoundToPage(bytes);
+      void* ptr = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (ptr == MAP_FAILED) {
+        throw std::bad_alloc();
+      }
+      numa_allocator_detail::Place(ptr, mapped, policy_, node_);
+      return {static_cast<T*>(ptr), sizeof(T) <= numa_allocator_detail::PageSize() ? mapped / sizeof(T) : count};
+    }
+#endif
+    return {static_cast<T*>(::operator new(bytes)), count};
+  }
+
+  void deallocate(T* ptr, size_t count) noexcept {  // NOLINT
+    const size_t bytes = count * sizeof(T);
+#if defined(__linux__)
+    if (bytes >= kMapThreshold) {
+      munmap(ptr, RoundToPage(bytes));
+      return;
+    }
+#endif
+    ::operator delete(ptr, bytes);
+  }
+
+  [[nodiscard]] NumaPolicy Policy() const noexcept {
+    return policy_;
+  }
+  [[nodiscard]] int Node() const noexcept {
+    return node_;
+  }
+
+ private:
+#if defined(__linux__)
+  [[nodiscard]] static size_t RoundToPage(size_t bytes) noexcept {
+    const size_t page = numa_allocator_detail::PageSize();
+    return (bytes + page - 1) / page * page;
+  }
+#endif
+
+  NumaPolicy policy_{NumaPolicy::kFirstTouch};
+  int node_{0};
+};
+
+template <typename T, typename U>
+[[nodiscard]] bool operator==(const NumaAllocator<T>& /*lhs*/, const NumaAllocator<U>& /*rhs*/) noexcept {
+  return true;
+}
+
+template <typename T, typename U>
+[[nodiscard]] bool operator!=(const NumaAllocator<T>& /*lhs*/, const NumaAllocator<U>& /*rhs*/) noexcept {
+  return false;
+}
+
+template <typename T>
+struct AllowsTrivialRelocation<NumaAllocator<T>> : std::true_type {};
+
+template <typename T, class GrowthPolicy = DoublingGrowth>
+using NumaVector = Vector<T, NumaAllocator<T>, GrowthPolicy>;
+
+// count copies of value in a buffer placed by alloc, built by ParallelFill on pool instead of
+// by the calling thread. With kFirstTouch each worker's partition lands on the worker's node;
+// scans that split the vector the same way on the same pool (the Parallel* functions) then
+// read mostly local memory, as far as the workers stay on their nodes.
+template <typename T, class GrowthPolicy = DoublingGrowth>
+[[nodiscard]] NumaVector<T, GrowthPolicy> MakeNumaVector(size_t count, const T& value,
+                                                         const NumaAllocator<T>& alloc = NumaAllocator<T>(),
+                                                         ThreadPool& pool = ThreadPool::Default()) {
+  NumaVector<T, GrowthPolicy> vec(alloc);
+  ParallelFill(vec, count, value, pool);
+  return vec;
+}
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_NUMA_ALLOCATOR_H_
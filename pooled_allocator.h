@@ -0,0 +1,180 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_POOLED_ALLOCATOR_H_
+#define OOP_ASSIGNMENTS_VECTOR_POOLED_ALLOCATOR_H_
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <new>
+
+#include "vector.h"
+
+namespace pooled_allocator_detail {
+
+// Blocks are power-of-two size classes from kMinBlockBytes to kMaxBlockBytes; larger ones
+// bypass the pool.
+inline constexpr size_t kMinBlockBytes = 64;
+inline constexpr size_t kMaxBlockBytes = size_t{1} << 20;
+inline constexpr size_t kClassCount = 15;
+// A bin keeps at most this many blocks, and at most kMaxBinBytes of them.
+inline constexpr size_t kMaxBlocksPerBin = 16;
+inline constexpr size_t kMaxBinBytes = size_t{1} << 20;
+
+static_assert(kMinBlockBytes << (kClassCount - 1) == kMaxBlockBytes);
+
+[[nodiscard]] constexpr size_t ClassOf(size_t bytes) noexcept {
+  size_t size_class = 0;
+  while ((kMinBlockBytes << size_class) < bytes) {
+    ++size_class;
+  }
+  return size_class;
+}
+
+[[nodiscard]] constexpr size_t ClassBytes(size_t size_class) noexcept {
+  return kMinBlockBytes << size_class;
+}
+
+// Free blocks of one thread, returned to operator delete when it exits.
+class BlockCache {
+ public:
+  BlockCache() noexcept = default;
+  BlockCache(const BlockCache&) = delete;
+  BlockCache& operator=(const BlockCache&) = delete;
+  ~BlockCache() {
+    Trim();
+    gone = true;
+  }
+
+  // The cache of the calling thread; nullptr while its thread-local objects are being
+  // destroyed, so that vectors destroyed late free their blocks directly.
+  [[nodiscard]] static BlockCache* Local() noexcept {
+    if (gone) {
+      return nullptr;
+    }
+    thread_local BlockCache cache;
+    return &cache;
+  }
+
+  [[nodiscard]] void* Take(size_t size_class) noexcept {
+    Bin& bin = bins_[size_class];
+    return bin.count == 0 ? nullptr : bin.blocks[--bin.count];
+  }
+
+  // Returns false if the bin is full; the caller keeps the block then.
+  [[nodiscard]] bool Give(size_t size_class, void* block) noexcept {
+    Bin& bin = bins_[size_class];
+    const size_t limit = std::min(kMaxBlocksPerBin, std::max<size_t>(kMaxBinBytes / ClassBytes(size_class), 1));
+    if (bin.count == limit) {
+      return false;
+    }
+    bin.blocks[bin.count++] = block;
+    return true;
+  }
+
+  void Trim() noexcept {
+    for (size_t size_class = 0; size_class < kClassCount; ++size_class) {
+      Bin& bin = bins_[size_class];
+      while (bin.count != 0) {
+        ::operator delete(bin.blocks[--bin.count], ClassBytes(size_class));
+      }
+    }
+  }
+
+ private:
+  struct Bin {
+    void* blocks[kMaxBlocksPerBin];
+    size_t count{0};
+  };
+
+  // Trivially destructible, so that it stays readable until the thread is gone.
+  static inline thread_local bool gone = false;
+
+  std::array<Bin, kClassCount> bins_{};
+};
+
+}  // namespace pooled_allocator_detail
+
+// Allocator that recycles blocks through per-thread bins of power-of-two size classes, so that
+// short-lived vectors stop paying malloc and free: a destroyed vector's buffer goes into the
+// bin of its class and the next vector growing through that class takes it back warm.
+// allocate_at_least reports the whole class, so growth fills it before moving on. Blocks freed
+// on another thread join that thread's bins. Blocks beyond kMaxBlockBytes, and those that find
+// their bin full, go straight to operator new and delete.
+template <typename T>
+class PooledAllocator {
+  static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "pooled blocks are not over-aligned");
+
+ public:
+  using value_type = T;  // NOLINT
+  using is_always_equal = std::true_type;  // NOLINT
+  using propagate_on_container_move_assignment = std::true_type;  // NOLINT
+
+  struct AllocationResult {
+    T* ptr;
+    size_t count;
+  };
+
+  PooledAllocator() noexcept = default;
+  template <typename U>
+  PooledAllocator(const PooledAllocator<U>& /*other*/) noexcept {  // NOLINT
+  }
+
+  [[nodiscard]] T* allocate(size_t count) {  // NOLINT
+    return allocate_at_least(count).ptr;
+  }
+
+  [[nodiscard]] AllocationResult allocate_at_least(size_t count) {  // NOLINT
+    if (count > static_cast<size_t>(-1) / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    const size_t bytes = count * sizeof(T);
+    if (bytes > pooled_allocator_detail::kMaxBlockBytes) {
+      return {static_cast<T*>(::operator new(bytes)), count};
+    }
+    const size_t size_class = pooled_allocator_detail::ClassOf(bytes);
+    void* block = nullptr;
+    if (auto cache = pooled_allocator_detail::BlockCache::Local()) {
+      block = cache->Take(size_class);
+    }
+    if (block == nullptr) {
+      block = ::operator new(pooled_allocator_detail::ClassBytes(size_class));
+    }
+    return {static_cast<T*>(block), pooled_allocator_detail::ClassBytes(size_class) / sizeof(T)};
+  }
+
+  void deallocate(T* ptr, size_t count) noexcept {  // NOLINT
+    const size_t bytes = count * sizeof(T);
+    if (bytes > pooled_allocator_detail::kMaxBlockBytes) {
+      ::operator delete(ptr, bytes);
+      return;
+    }
+    const size_t size_class = pooled_allocator_detail::ClassOf(bytes);
+    auto cache = pooled_allocator_detail::BlockCache::Local();
+    if (cache == nullptr || !cache->Give(size_class, ptr)) {
+      ::operator delete(ptr, pooled_allocator_detail::ClassBytes(size_class));
+    }
+  }
+
+  // Frees the blocks cached by the calling thread.
+  static void Trim() noexcept {
+    if (auto cache = pooled_allocator_detail::BlockCache::Local()) {
+      cache->Trim();
+    }
+  }
+};
+
+template <typename T, typename U>
+[[nodiscard]] bool operator==(const PooledAllocator<T>& /*lhs*/, const PooledAllocator<U>& /*rhs*/) noexcept {
+  return true;
+}
+
+template <typename T, typename U>
+[[nodiscard]] bool operator!=(const PooledAllocator<T>& /*lhs*/, const PooledAllocator<U>& /*rhs*/) noexcept {
+  return false;
+}
+
+template <typename T>
+struct AllowsTrivialRelocation<PooledAllocator<T>> : std::true_type {};
+
+template <typename T, class GrowthPolicy = DoublingGrowth>
+using PooledVector = Vector<T, PooledAllocator<T>, GrowthPolicy>;
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_POOLED_ALLOCATOR_H_
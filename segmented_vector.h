@@ -0,0 +1,658 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_SEGMENTED_VECTOR_H_
+#define OOP_ASSIGNMENTS_VECTOR_SEGMENTED_VECTOR_H_
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+#include "vector.h"
+
+namespace segmented_vector_detail {
+
+[[nodiscard]] constexpr size_t FloorPow2(size_t value) noexcept {
+  size_t pow = 1;
+  while (pow <= value / 2) {
+    pow *= 2;
+  }
+  return pow;
+}
+
+// About a page per block, and never fewer than 16 elements.
+template <typename T>
+inline constexpr size_t kDefaultBlockSize = FloorPow2(std::max<size_t>(4096 / sizeof(T), 16));
+
+}  // namespace segmented_vector_detail
+
+// Vector with the same interface whose elements live in fixed blocks of BlockSize elements,
+// reached through an index of block pointers. Growing allocates one block and appends one
+// pointer to the index, so EmplaceBack never moves elements, the worst case append costs a
+// block allocation instead of a copy of the whole buffer, and references stay valid until the
+// element is erased. Random access costs one extra load; iterators walk a block with a plain
+// pointer and only consult the index when they cross into the next one.
+template <typename T, class Allocator = std::allocator<T>,
+          size_t BlockSize = segmented_vector_detail::kDefaultBlockSize<T>>
+class SegmentedVector {
+  static_assert(BlockSize != 0 && (BlockSize & (BlockSize - 1)) == 0, "BlockSize must be a power of two");
+
+  using AllocTraits = std::allocator_traits<Allocator>;
+  using IndexAllocator = typename AllocTraits::template rebind_alloc<T*>;
+
+  template <bool kConst>
+  class BasicIterator;
+
+ public:
+  using ValueType = T;
+  using Pointer = T*;
+  using ConstPointer = const T*;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+  using Iterator = BasicIterator<false>;
+  using ConstIterator = BasicIterator<true>;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+  static constexpr size_t kBlockSize = BlockSize;
+
+ private:
+  template <class Iter>
+  using EnableIfInputIter = std::enable_if_t<
+      std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>>;
+
+ public:
+  SegmentedVector() noexcept(noexcept(Allocator())) = default;
+  explicit SegmentedVector(const Allocator& alloc) noexcept : alloc_(alloc), blocks_(IndexAllocator(alloc_)) {
+  }
+  explicit SegmentedVector(size_t size, const Allocator& alloc = Allocator()) : SegmentedVector(alloc) {
+    Resize(size);
+  }
+  SegmentedVector(size_t size, const T& value, const Allocator& alloc = Allocator()) : SegmentedVector(alloc) {
+    Resize(size, value);
+  }
+  SegmentedVector(std::initializer_list<T> init_lst, const Allocator& alloc = Allocator()) : SegmentedVector(alloc) {
+    AppendRange(init_lst.begin(), init_lst.end());
+  }
+  template <typename InputIterator, typename = EnableIfInputIter<InputIterator>>
+  SegmentedVector(InputIterator first, InputIterator last, const Allocator& alloc = Allocator())
+      : SegmentedVector(alloc) {
+    AppendRange(first, last);
+  }
+  // Copies a contiguous Vector block by block.
+  template <class Growth>
+  explicit SegmentedVector(const Vector<T, Allocator, Growth>& other) : SegmentedVector(other.GetAllocator()) {
+    AppendRange(other.begin(), other.end());
+  }
+  template <class Growth>
+  explicit SegmentedVector(Vector<T, Allocator, Growth>&& other) : SegmentedVector(other.GetAllocator()) {
+    AppendRange(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    other.Clear();
+  }
+
+  SegmentedVector(const SegmentedVector& other)
+      : SegmentedVector(other, AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+  }
+  SegmentedVector(const SegmentedVector& other, const Allocator& alloc) : SegmentedVector(alloc) {
+    AppendRange(other.begin(), other.end());
+  }
+  SegmentedVector(SegmentedVector&& other) noexcept
+      : alloc_(other.alloc_), blocks_(std::move(other.blocks_)), size_(std::exchange(other.size_, 0)) {
+  }
+
+  SegmentedVector& operator=(const SegmentedVector& other) {
+    if (this != &other) {
+      if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+        if (alloc_ != other.alloc_) {
+          ReleaseStorage();
+          alloc_ = other.alloc_;
+          blocks_ = Index(IndexAllocator(alloc_));
+        }
+      }
+      Assign(other.begin(), other.end());
+    }
+    return *this;
+  }
+  // With unequal allocators that do not propagate, the elements are moved one by one into
+  // this vector's blocks.
+  SegmentedVector& operator=(SegmentedVector&& other) noexcept(
+      AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value) {
+    if (this != &other) {
+      if (AllocTraits::propagate_on_container_move_assignment::value || alloc_ == other.alloc_) {
+        ReleaseStorage();
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+          alloc_ = other.alloc_;
+        }
+        blocks_ = std::move(other.blocks_);
+        size_ = std::exchange(other.size_, 0);
+      } else {
+        Assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        other.Clear();
+      }
+    }
+    return *this;
+  }
+
+  ~SegmentedVector() {
+    ReleaseStorage();
+  }
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return size_;
+  }
+  [[nodiscard]] SizeType Capacity() const noexcept {
+    return BlockCount() * kBlockSize;
+  }
+  [[nodiscard]] bool Empty() const noexcept {
+    return size_ == 0;
+  }
+  [[nodiscard]] ConstReference Front() const noexcept {
+    return *blocks_[0];
+  }
+  [[nodiscard]] Reference Front() noexcept {
+    return *blocks_[0];
+  }
+  [[nodiscard]] ConstReference Back() const noexcept {
+    return (*this)[size_ - 1];
+  }
+  [[nodiscard]] Reference Back() noexcept {
+    return (*this)[size_ - 1];
+  }
+  [[nodiscard]] ConstReference At(size_t idx) const {
+    if (idx >= size_) {
+      throw std::out_of_range("");
+    }
+    return (*this)[idx];
+  }
+  [[nodiscard]] Reference At(size_t idx) {
+    if (idx >= size_) {
+      throw std::out_of_range("");
+    }
+    return (*this)[idx];
+  }
+  [[nodiscard]] ConstReference operator[](size_t idx) const noexcept {
+    return *Slot(idx);
+  }
+  [[nodiscard]] Reference operator[](size_t idx) noexcept {
+    return *Slot(idx);
+  }
+
+  // Blocks in use, for processing the elements one contiguous run at a time: block k holds
+  // BlockLength(k) elements starting at Block(k).
+  [[nodiscard]] size_t BlockCount() const noexcept {
+    return blocks_.Empty() ? 0 : blocks_.Size() - 1;
+  }
+  [[nodiscard]] ConstPointer Block(size_t block) const noexcept {
+    return blocks_[block];
+  }
+  [[nodiscard]] Pointer Block(size_t block) noexcept {
+    return blocks_[block];
+  }
+  [[nodiscard]] size_t BlockLength(size_t block) const noexcept {
+    const size_t begin = block * kBlockSize;
+    return size_ <= begin ? 0 : std::min(kBlockSize, size_ - begin);
+  }
+
+  [[nodiscard]] Allocator GetAllocator() const noexcept {
+    return alloc_;
+  }
+
+  // Allocators are only exchanged when they propagate on swap; otherwise they must compare equal.
+  void Swap(SegmentedVector& other) noexcept {
+    blocks_.Swap(other.blocks_);
+    std::swap(size_, other.size_);
+    if constexpr (AllocTraits::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
+  }
+  // Keeps the blocks for reuse.
+  void Clear() noexcept {
+    Truncate(0);
+  }
+  void Resize(size_t size) {
+    ResizeWith(size, [&](Pointer gap, size_t count) { ElementOps::ValueInitTo(alloc_, gap, count); });
+  }
+  void Resize(size_t size, const T& value) {
+    if (size > size_ && IsElement(value)) {
+      T copy(value);
+      Resize(size, copy);
+      return;
+    }
+    ResizeWith(size, [&](Pointer gap, size_t count) { ElementOps::FillTo(alloc_, gap, count, value); });
+  }
+  void ResizeDefaultInit(size_t size) {
+    ResizeWith(size, [&](Pointer gap, size_t count) { ElementOps::DefaultInitTo(alloc_, gap, count); });
+  }
+  void Reserve(size_t capacity) {
+    if (capacity <= Capacity()) {
+      return;
+    }
+    const size_t blocks = (capacity - 1) / kBlockSize + 1;
+    blocks_.Reserve(blocks + 1);
+    while (BlockCount() < blocks) {
+      AddBlock();
+    }
+  }
+  // Frees the blocks past the last element.
+  void ShrinkToFit() {
+    const size_t used = (size_ + kBlockSize - 1) / kBlockSize;
+    while (BlockCount() > used) {
+      AllocTraits::deallocate(alloc_, blocks_[BlockCount() - 1], kBlockSize);
+      blocks_.PopBack();
+      blocks_.Back() = nullptr;
+    }
+    if (used == 0) {
+      blocks_.Clear();
+    }
+    blocks_.ShrinkToFit();
+  }
+
+  // The arguments may refer to elements of this vector, none of which move.
+  template <class... Args>
+  void EmplaceBack(Args&&... args) {
+    if (size_ == Capacity()) {
+      AddBlock();
+    }
+    AllocTraits::construct(alloc_, Slot(size_), std::forward<Args>(args)...);
+    ++size_;
+  }
+  void PushBack(const T& value) {
+    EmplaceBack(value);
+  }
+  void PushBack(T&& value) {
+    EmplaceBack(std::move(value));
+  }
+  void PopBack() noexcept {
+    if (!Empty()) {
+      Truncate(size_ - 1);
+    }
+  }
+
+  // Inserting and erasing in the middle shift the tail element by element across blocks.
+  template <class... Args>
+  Iterator EmplaceAt(ConstIterator pos, Args&&... args) {
+    const auto idx = static_cast<size_t>(pos - cbegin());
+    EmplaceBack(std::forward<Args>(args)...);
+    std::rotate(begin() + idx, end() - 1, end());
+    return begin() + idx;
+  }
+  Iterator Insert(ConstIterator pos, const T& value) {
+    return EmplaceAt(pos, value);
+  }
+  Iterator Insert(ConstIterator pos, T&& value) {
+    return EmplaceAt(pos, std::move(value));
+  }
+  Iterator Insert(ConstIterator pos, size_t count, const T& value) {
+    const auto idx = static_cast<size_t>(pos - cbegin());
+    const size_t old_size = size_;
+    Resize(size_ + count, value);
+    std::rotate(begin() + idx, begin() + old_size, end());
+    return begin() + idx;
+  }
+  template <typename InputIterator, typename = EnableIfInputIter<InputIterator>>
+  Iterator Insert(ConstIterator pos, InputIterator first, InputIterator last) {
+    const auto idx = static_cast<size_t>(pos - cbegin());
+    const size_t old_size = size_;
+    AppendRange(first, last);
+    std::rotate(begin() + idx, begin() + old_size, end());
+    return begin() + idx;
+  }
+  Iterator Insert(ConstIterator pos, std::initializer_list<T> init_lst) {
+    return Insert(pos, init_lst.begin(), init_lst.end());
+  }
+
+  Iterator Erase(ConstIterator pos) {
+    return Erase(pos, pos + 1);
+  }
+  // Basic guarantee if a move assignment throws.
+  Iterator Erase(ConstIterator first, ConstIterator last) {
+    const auto idx = static_cast<size_t>(first - cbegin());
+    const auto count = static_cast<size_t>(last - first);
+    if (count != 0) {
+      std::move(begin() + idx + count, end(), begin() + idx);
+      Truncate(size_ - count);
+    }
+    return begin() + idx;
+  }
+
+  // Reuses the blocks already allocated; basic guarantee if a copy throws.
+  template <typename InputIterator, typename = EnableIfInputIter<InputIterator>>
+  void Assign(InputIterator first, InputIterator last) {
+    Clear();
+    AppendRange(first, last);
+  }
+  void Assign(size_t count, const T& value) {
+    if (IsElement(value)) {
+      T copy(value);
+      Assign(count, copy);
+      return;
+    }
+    Clear();
+    Resize(count, value);
+  }
+  void Assign(std::initializer_list<T> init_lst) {
+    Assign(init_lst.begin(), init_lst.end());
+  }
+
+  // Appends [first, last); strong guarantee with respect to the elements.
+  template <typename InputIterator, typename = EnableIfInputIter<InputIterator>>
+  void AppendRange(InputIterator first, InputIterator last) {
+    using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+      Reserve(size_ + static_cast<size_t>(std::distance(first, last)));
+    }
+    const size_t old_size = size_;
+    try {
+      for (; first != last; ++first) {
+        EmplaceBack(*first);
+      }
+    } catch (...) {
+      Truncate(old_size);
+      throw;
+    }
+  }
+
+  // Contiguous copy, or move of the elements for an rvalue.
+  template <class Growth = DoublingGrowth>
+  [[nodiscard]] Vector<T, Allocator, Growth> ToVector() const& {
+    Vector<T, Allocator, Growth> result(AllocTraits::select_on_container_copy_construction(alloc_));
+    result.Reserve(size_);
+    for (size_t block = 0; block * kBlockSize < size_; ++block) {
+      result.AppendRange(Block(block), Block(block) + BlockLength(block));
+    }
+    return result;
+  }
+  template <class Growth = DoublingGrowth>
+  [[nodiscard]] Vector<T, Allocator, Growth> ToVector() && {
+    Vector<T, Allocator, Growth> result(alloc_);
+    result.Reserve(size_);
+    for (size_t block = 0; block * kBlockSize < size_; ++block) {
+      result.AppendRange(std::make_move_iterator(Block(block)),
+                         std::make_move_iterator(Block(block) + BlockLength(block)));
+    }
+    Clear();
+    return result;
+  }
+
+  [[nodiscard]] ConstIterator cbegin() const noexcept {  // NOLINT
+    return ConstIterator(IndexData(), 0);
+  }
+  [[nodiscard]] ConstIterator begin() const noexcept {  // NOLINT
+    return cbegin();
+  }
+  [[nodiscard]] Iterator begin() noexcept {  // NOLINT
+    return Iterator(IndexData(), 0);
+  }
+  [[nodiscard]] ConstIterator cend() const noexcept {  // NOLINT
+    return ConstIterator(IndexData(), size_);
+  }
+  [[nodiscard]] ConstIterator end() const noexcept {  // NOLINT
+    return cend();
+  }
+  [[nodiscard]] Iterator end() noexcept {  // NOLINT
+    return Iterator(IndexData(), size_);
+  }
+  [[nodiscard]] ConstReverseIterator crbegin() const noexcept {  // NOLINT
+    return ConstReverseIterator(cend());
+  }
+  [[nodiscard]] ConstReverseIterator rbegin() const noexcept {  // NOLINT
+    return crbegin();
+  }
+  [[nodiscard]] ReverseIterator rbegin() noexcept {  // NOLINT
+    return ReverseIterator(end());
+  }
+  [[nodiscard]] ConstReverseIterator crend() const noexcept {  // NOLINT
+    return ConstReverseIterator(cbegin());
+  }
+  [[nodiscard]] ConstReverseIterator rend() const noexcept {  // NOLINT
+    return crend();
+  }
+  [[nodiscard]] ReverseIterator rend() noexcept {  // NOLINT
+    return ReverseIterator(begin());
+  }
+
+ private:
+  using ElementOps = vector_detail::ElementOps<T, Allocator>;
+  using Index = Vector<T*, IndexAllocator>;
+
+  static constexpr size_t kBlockShift = [] {
+    size_t shift = 0;
+    while ((size_t{1} << shift) < kBlockSize) {
+      ++shift;
+    }
+    return shift;
+  }();
+
+  // Position of an element as (slot of its block in the index, element within the block). The
+  // index keeps a null pointer after the last block, so an iterator that steps past the last
+  // allocated block reads null instead of leaving the index; an empty vector uses kNoBlocks.
+  template <bool kConst>
+  class BasicIterator {
+    using Element = std::conditional_t<kConst, const T, T>;
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;  // NOLINT
+    using value_type = T;  // NOLINT
+    using difference_type = ptrdiff_t;  // NOLINT
+    using pointer = Element*;  // NOLINT
+    using reference = Element&;  // NOLINT
+
+    BasicIterator() noexcept = default;
+    template <bool kOtherConst, typename = std::enable_if_t<kConst && !kOtherConst>>
+    BasicIterator(const BasicIterator<kOtherConst>& other) noexcept  // NOLINT
+        : block_(other.block_), curr_(other.curr_) {
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {
+      return *curr_;
+    }
+    [[nodiscard]] pointer operator->() const noexcept {
+      return curr_;
+    }
+    [[nodiscard]] reference operator[](difference_type n) const noexcept {
+      return *(*this + n);
+    }
+
+    BasicIterator& operator++() noexcept {
+      if (++curr_ == *block_ + kBlockSize) {
+        curr_ = *++block_;
+      }
+      return *this;
+    }
+    BasicIterator operator++(int) noexcept {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+    BasicIterator& operator--() noexcept {
+      if (curr_ == *block_) {
+        curr_ = *--block_ + kBlockSize;
+      }
+      --curr_;
+      return *this;
+    }
+    BasicIterator operator--(int) noexcept {
+      auto copy = *this;
+      --*this;
+      return copy;
+    }
+    BasicIterator& operator+=(difference_type n) noexcept {
+      const difference_type offset = Offset() + n;
+      // Arithmetic shift floors, so negative offsets land in earlier blocks.
+      block_ += offset >> kBlockShift;
+      curr_ = *block_ + (offset & static_cast<difference_type>(kBlockSize - 1));
+      return *this;
+    }
+    BasicIterator& operator-=(difference_type n) noexcept {
+      return *this += -n;
+    }
+    [[nodiscard]] friend BasicIterator operator+(BasicIterator it, difference_type n) noexcept {
+      return it += n;
+    }
+    [[nodiscard]] friend BasicIterator operator+(difference_type n, BasicIterator it) noexcept {
+      return it += n;
+    }
+    [[nodiscard]] friend BasicIterator operator-(BasicIterator it, difference_type n) noexcept {
+      return it -= n;
+    }
+    [[nodiscard]] friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return ((lhs.block_ - rhs.block_) << kBlockShift) + lhs.Offset() - rhs.Offset();
+    }
+
+    [[nodiscard]] friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return lhs.curr_ == rhs.curr_ && lhs.block_ == rhs.block_;
+    }
+    [[nodiscard]] friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return !(lhs == rhs);
+    }
+    [[nodiscard]] friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return lhs - rhs < 0;
+    }
+    [[nodiscard]] friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return rhs < lhs;
+    }
+    [[nodiscard]] friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return !(rhs < lhs);
+    }
+    [[nodiscard]] friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return !(lhs < rhs);
+    }
+
+   private:
+    friend class SegmentedVector;
+    template <bool>
+    friend class BasicIterator;
+
+    BasicIterator(T* const* index, size_t idx) noexcept
+        : block_(index + (idx >> kBlockShift)), curr_(*block_ + (idx & (kBlockSize - 1))) {
+    }
+
+    [[nodiscard]] difference_type Offset() const noexcept {
+      return curr_ - *block_;
+    }
+
+    T* const* block_{nullptr};
+    Element* curr_{nullptr};
+  };
+
+  static inline T* const kNoBlocks[1] = {nullptr};
+
+  [[nodiscard]] T* const* IndexData() const noexcept {
+    return blocks_.Empty() ? kNoBlocks : blocks_.Data();
+  }
+
+  [[nodiscard]] T* Slot(size_t idx) const noexcept {
+    return blocks_[idx >> kBlockShift] + (idx & (kBlockSize - 1));
+  }
+
+  [[nodiscard]] bool IsElement(const T& value) const noexcept {
+    const T* ptr = std::addressof(value);
+    for (size_t block = 0; block * kBlockSize < size_; ++block) {
+      if (std::less_equal<const T*>()(Block(block), ptr) && std::less<const T*>()(ptr, Block(block) + kBlockSize)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // The null terminator is pushed first, so a failed allocation leaves the index as it was.
+  void AddBlock() {
+    if (blocks_.Empty()) {
+      blocks_.PushBack(nullptr);
+    }
+    blocks_.PushBack(nullptr);
+    try {
+      blocks_[blocks_.Size() - 2] = AllocTraits::allocate(alloc_, kBlockSize);
+    } catch (...) {
+      blocks_.PopBack();
+      throw;
+    }
+  }
+
+  // Destroys the elements from position size onwards, one block at a time.
+  void Truncate(size_t size) noexcept {
+    while (size_ > size) {
+      const size_t block = (size_ - 1) >> kBlockShift;
+      const size_t first = std::max(size, block * kBlockSize);
+      ElementOps::Destroy(alloc_, Slot(first), size_ - first);
+      size_ = first;
+    }
+  }
+
+  // Constructs the new elements block by block with build(gap, count); strong guarantee.
+  template <class Builder>
+  void ResizeWith(size_t size, Builder&& build) {
+    if (size <= size_) {
+      Truncate(size);
+      return;
+    }
+    Reserve(size);
+    const size_t old_size = size_;
+    try {
+      while (size_ < size) {
+        const size_t count = std::min(size - size_, kBlockSize - (size_ & (kBlockSize - 1)));
+        build(Slot(size_), count);
+        size_ += count;
+      }
+    } catch (...) {
+      Truncate(old_size);
+      throw;
+    }
+  }
+
+  void ReleaseStorage() noexcept {
+    Truncate(0);
+    for (size_t block = 0; block < BlockCount(); ++block) {
+      AllocTraits::deallocate(alloc_, blocks_[block], kBlockSize);
+    }
+    blocks_.Clear();
+  }
+
+  Allocator alloc_{Allocator{}};
+  Index blocks_{IndexAllocator(alloc_)};
+  size_t size_{0};
+};
+
+// Removes the elements satisfying pred in a single compacting pass and returns their number.
+template <typename T, class Alloc, size_t BlockSize, class Predicate>
+size_t EraseIf(SegmentedVector<T, Alloc, BlockSize>& vec, Predicate pred) {
+  auto new_end = std::remove_if(vec.begin(), vec.end(), pred);
+  const auto count = static_cast<size_t>(vec.end() - new_end);
+  vec.Erase(new_end, vec.end());
+  return count;
+}
+
+template <typename T, class Alloc, size_t BlockSize>
+[[nodiscard]] bool operator==(const SegmentedVector<T, Alloc, BlockSize>& lhs,
+                              const SegmentedVector<T, Alloc, BlockSize>& rhs) {
+  return lhs.Size() == rhs.Size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, class Alloc, size_t BlockSize>
+[[nodiscard]] bool operator<(const SegmentedVector<T, Alloc, BlockSize>& lhs,
+                             const SegmentedVector<T, Alloc, BlockSize>& rhs) {
+  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, class Alloc, size_t BlockSize>
+[[nodiscard]] bool operator!=(const SegmentedVector<T, Alloc, BlockSize>& lhs,
+                              const SegmentedVector<T, Alloc, BlockSize>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename T, class Alloc, size_t BlockSize>
+[[nodiscard]] bool operator>(const SegmentedVector<T, Alloc, BlockSize>& lhs,
+                             const SegmentedVector<T, Alloc, BlockSize>& rhs) {
+  return rhs < lhs;
+}
+
+template <typename T, class Alloc, size_t BlockSize>
+[[nodiscard]] bool operator<=(const SegmentedVector<T, Alloc, BlockSize>& lhs,
+                              const SegmentedVector<T, Alloc, BlockSize>& rhs) {
+  return !(lhs > rhs);
+}
+
+template <typename T, class Alloc, size_t BlockSize>
+[[nodiscard]] bool operator>=(const SegmentedVector<T, Alloc, BlockSize>& lhs,
+                              const SegmentedVector<T, Alloc, BlockSize>& rhs) {
+  return !(lhs < rhs);
+}
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_SEGMENTED_VECTOR_H_
@@ -0,0 +1,159 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_SHARED_VECTOR_H_
+#define OOP_ASSIGNMENTS_VECTOR_SHARED_VECTOR_H_
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "vector.h"
+#include "vector_view.h"
+
+// Immutable, reference-counted snapshot of a Vector. Freeze moves the vector in without
+// touching its elements, copies share the buffer in O(1), and Thaw turns a snapshot back into
+// a Vector, copying the elements only if other snapshots still share them. Copies may be read
+// and destroyed on any thread; a SharedVector object itself is not synchronized, so publishing
+// a new snapshot to readers still takes a mutex or similar around the swap.
+template <typename T, class Allocator = std::allocator<T>, class GrowthPolicy = DoublingGrowth>
+class SharedVector {
+ public:
+  using Target = Vector<T, Allocator, GrowthPolicy>;
+  using ValueType = T;
+  using ConstPointer = const T*;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+  using ConstIterator = ConstPointer;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+  SharedVector() noexcept = default;
+  // Spare capacity is kept; ShrinkToFit first to drop it.
+  explicit SharedVector(Target&& vector) : block_(new Block{{1}, std::move(vector)}) {
+  }
+  SharedVector(const SharedVector& other) noexcept : block_(other.block_) {
+    if (block_ != nullptr) {
+      block_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  SharedVector(SharedVector&& other) noexcept : block_(std::exchange(other.block_, nullptr)) {
+  }
+  SharedVector& operator=(const SharedVector& other) noexcept {
+    SharedVector(other).Swap(*this);
+    return *this;
+  }
+  SharedVector& operator=(SharedVector&& other) noexcept {
+    SharedVector(std::move(other)).Swap(*this);
+    return *this;
+  }
+  ~SharedVector() {
+    Unref();
+  }
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return block_ == nullptr ? 0 : block_->vector.Size();
+  }
+  [[nodiscard]] bool Empty() const noexcept {
+    return Size() == 0;
+  }
+  [[nodiscard]] ConstPointer Data() const noexcept {
+    return block_ == nullptr ? nullptr : block_->vector.Data();
+  }
+  [[nodiscard]] ConstReference operator[](size_t idx) const noexcept {
+    return Data()[idx];
+  }
+  [[nodiscard]] ConstReference At(size_t idx) const {
+    if (idx >= Size()) {
+      throw std::out_of_range("");
+    }
+    return Data()[idx];
+  }
+  [[nodiscard]] ConstReference Front() const noexcept {
+    return Data()[0];
+  }
+  [[nodiscard]] ConstReference Back() const noexcept {
+    return Data()[Size() - 1];
+  }
+  [[nodiscard]] ConstVectorView<T> View() const noexcept {
+    return {Data(), Size()};
+  }
+
+  // Number of snapshots sharing the buffer, 0 for an empty SharedVector. Other threads may
+  // change it at any time, except from 1 while this is the only reference.
+  [[nodiscard]] size_t UseCount() const noexcept {
+    return block_ == nullptr ? 0 : block_->refs.load(std::memory_order_acquire);
+  }
+  [[nodiscard]] bool IsUnique() const noexcept {
+    return UseCount() == 1;
+  }
+
+  // A copy of the elements, always; the snapshot is unchanged.
+  [[nodiscard]] Target Thaw() const& {
+    return block_ == nullptr ? Target() : Target(block_->vector);
+  }
+  // Takes the vector back without copying if this is the only reference, and leaves this
+  // SharedVector empty.
+  [[nodiscard]] Target Thaw() && {
+    if (block_ == nullptr) {
+      return Target();
+    }
+    Target vector = IsUnique() ? std::move(block_->vector) : Target(block_->vector);
+    Unref();
+    block_ = nullptr;
+    return vector;
+  }
+
+  void Swap(SharedVector& other) noexcept {
+    std::swap(block_, other.block_);
+  }
+
+  [[nodiscard]] ConstIterator begin() const noexcept {  // NOLINT
+    return Data();
+  }
+  [[nodiscard]] ConstIterator end() const noexcept {  // NOLINT
+    return Data() + Size();
+  }
+  [[nodiscard]] ConstIterator cbegin() const noexcept {  // NOLINT
+    return begin();
+  }
+  [[nodiscard]] ConstIterator cend() const noexcept {  // NOLINT
+    return end();
+  }
+  [[nodiscard]] ConstReverseIterator rbegin() const noexcept {  // NOLINT
+    return ConstReverseIterator(end());
+  }
+  [[nodiscard]] ConstReverseIterator rend() const noexcept {  // NOLINT
+    return ConstReverseIterator(begin());
+  }
+
+ private:
+  struct Block {
+    std::atomic<size_t> refs;
+    Target vector;
+  };
+
+  // The acquire on the last release orders the other owners' reads before the destruction.
+  void Unref() noexcept {
+    if (block_ != nullptr && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete block_;
+    }
+  }
+
+  Block* block_{nullptr};
+};
+
+template <typename T, class Alloc, class Growth>
+[[nodiscard]] SharedVector<T, Alloc, Growth> Freeze(Vector<T, Alloc, Growth>&& vector) {
+  return SharedVector<T, Alloc, Growth>(std::move(vector));
+}
+
+template <typename T, class Alloc, class Growth>
+[[nodiscard]] bool operator==(const SharedVector<T, Alloc, Growth>& lhs, const SharedVector<T, Alloc, Growth>& rhs) {
+  return lhs.Data() == rhs.Data() || std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, class Alloc, class Growth>
+[[nodiscard]] bool operator!=(const SharedVector<T, Alloc, Growth>& lhs, const SharedVector<T, Alloc, Growth>& rhs) {
+  return !(lhs == rhs);
+}
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_SHARED_VECTOR_H_
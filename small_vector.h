@@ -0,0 +1,522 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_SMALL_VECTOR_H_
+#define OOP_ASSIGNMENTS_VECTOR_SMALL_VECTOR_H_
+#include <algorithm>
+#include <iterator>
+
+#include "vector.h"
+
+// Vector that keeps up to N elements in inline storage and only goes to the allocator once it
+// outgrows them. Moving or swapping an inline SmallVector moves its elements one by one.
+// Allocators propagate as in Vector.
+template <typename T, size_t N, class Allocator = std::allocator<T>, class GrowthPolicy = DoublingGrowth>
+class SmallVector {
+  static_assert(N > 0, "use Vector for N == 0");
+
+ public:
+  using ValueType = T;
+  using Pointer = T*;
+  using ConstPointer = const T*;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+  using Iterator = Pointer;
+  using ConstIterator = ConstPointer;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+  static constexpr size_t kInlineCapacity = N;
+
+ private:
+  using AllocTraits = std::allocator_traits<Allocator>;
+  using ElementOps = vector_detail::ElementOps<T, Allocator>;
+  using PositionOps = vector_detail::PositionOps<T, Allocator>;
+  friend PositionOps;
+
+  template <class Iter>
+  using EnableIfForwardIter = std::enable_if_t<
+      std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>>;
+
+  static constexpr bool kNothrowMove = std::is_nothrow_move_constructible_v<T>;
+  static constexpr bool kPropagateOnCopy = AllocTraits::propagate_on_container_copy_assignment::value;
+  static constexpr bool kPropagateOnMove = AllocTraits::propagate_on_container_move_assignment::value;
+  static constexpr bool kNothrowMoveAssign =
+      kNothrowMove && (kPropagateOnMove || AllocTraits::is_always_equal::value);
+
+ public:
+  SmallVector() noexcept : buffer_(InlineBuffer()) {
+  }
+  explicit SmallVector(const Allocator& alloc) noexcept : alloc_(alloc), buffer_(InlineBuffer()) {
+  }
+  SmallVector(std::initializer_list<T> init_lst, const Allocator& alloc = Allocator())
+      : SmallVector(init_lst.begin(), init_lst.end(), alloc) {
+  }
+
+  template <typename InputIterator, typename = EnableIfForwardIter<InputIterator>>
+  SmallVector(InputIterator begin, InputIterator end, const Allocator& alloc = Allocator()) : SmallVector(alloc) {
+    const auto count = static_cast<size_t>(std::distance(begin, end));
+    AllocateExactly(count);
+    try {
+      ElementOps::CopyIterTo(alloc_, begin, end, buffer_);
+    } catch (...) {
+      ReleaseBuffer();
+      throw;
+    }
+    size_ = count;
+  }  // copy safety
+
+  SmallVector(const SmallVector& other)
+      : SmallVector(other, AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+  }
+  SmallVector(const SmallVector& other, const Allocator& alloc) : SmallVector(other.begin(), other.end(), alloc) {
+  }
+
+  SmallVector(SmallVector&& other) noexcept(kNothrowMove) : SmallVector(other.alloc_) {
+    TakeFrom(other);
+  }
+  // Moves element by element when alloc cannot free other's buffer.
+  SmallVector(SmallVector&& other, const Allocator& alloc) : SmallVector(alloc) {
+    if (alloc_ == other.alloc_) {
+      TakeFrom(other);
+    } else {
+      MoveElementsFrom(other);
+    }
+  }
+
+  explicit SmallVector(size_t size, const Allocator& alloc = Allocator()) : SmallVector(alloc) {
+    AllocateExactly(size);
+    size_t count = 0;
+    try {
+      for (; count < size; ++count) {
+        AllocTraits::construct(alloc_, buffer_ + count);
+      }
+    } catch (...) {
+      ElementOps::Destroy(alloc_, buffer_, count);
+      ReleaseBuffer();
+      throw;
+    }
+    size_ = size;
+  }
+
+  SmallVector(size_t size, const T& value, const Allocator& alloc = Allocator()) : SmallVector(alloc) {
+    AllocateExactly(size);
+    try {
+      ElementOps::FillTo(alloc_, buffer_, size, value);
+    } catch (...) {
+      ReleaseBuffer();
+      throw;
+    }
+    size_ = size;
+  }
+
+  SmallVector& operator=(const SmallVector& other) {
+    if (this != &other) {
+      SmallVector copy(other, kPropagateOnCopy ? other.alloc_ : alloc_);
+      Clear();
+      ReleaseBuffer();
+      if constexpr (kPropagateOnCopy) {
+        alloc_ = copy.alloc_;
+      }
+      TakeFrom(copy);
+    }
+    return *this;
+  }
+  // With unequal allocators that do not propagate, the elements are moved one by one into
+  // this vector's storage.
+  SmallVector& operator=(SmallVector&& other) noexcept(kNothrowMoveAssign) {
+    if (this != &other) {
+      Clear();
+      ReleaseBuffer();
+      if constexpr (kPropagateOnMove) {
+        alloc_ = other.alloc_;
+        TakeFrom(other);
+      } else if (AllocTraits::is_always_equal::value || alloc_ == other.alloc_) {
+        TakeFrom(other);
+      } else {
+        MoveElementsFrom(other);
+      }
+    }
+    return *this;
+  }
+
+  ~SmallVector() noexcept(std::is_nothrow_destructible_v<ValueType>) {
+    ElementOps::Destroy(alloc_, buffer_, size_);
+    ReleaseBuffer();
+  }
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return size_;
+  }
+  [[nodiscard]] SizeType Capacity() const noexcept {
+    return capacity_;
+  }
+  [[nodiscard]] bool Empty() const noexcept {
+    return size_ == 0;
+  }
+  [[nodiscard]] bool IsInline() const noexcept {
+    return buffer_ == InlineBuffer();
+  }
+  [[nodiscard]] Allocator GetAllocator() const noexcept {
+    return alloc_;
+  }
+  [[nodiscard]] ConstReference Front() const noexcept {
+    return buffer_[0];
+  }
+  [[nodiscard]] Reference Front() noexcept {
+    return buffer_[0];
+  }
+  [[nodiscard]] ConstReference Back() const noexcept {
+    return buffer_[size_ - 1];
+  }
+  [[nodiscard]] Reference Back() noexcept {
+    return buffer_[size_ - 1];
+  }
+  [[nodiscard]] ConstReference At(size_t idx) const {
+    if (idx >= size_) {
+      throw std::out_of_range("");
+    }
+    return buffer_[idx];
+  }
+  [[nodiscard]] Reference At(size_t idx) {
+    return const_cast<T&>(const_cast<const SmallVector&>(*this).At(idx));
+  }
+  [[nodiscard]] ConstPointer Data() const noexcept {
+    return buffer_;
+  }
+  [[nodiscard]] Pointer Data() noexcept {
+    return buffer_;
+  }
+  [[nodiscard]] ConstReference operator[](size_t idx) const noexcept {
+    return buffer_[idx];
+  }
+  [[nodiscard]] Reference operator[](size_t idx) noexcept {
+    return buffer_[idx];
+  }
+
+  // Allocators are only exchanged when they propagate on swap; otherwise they must compare equal.
+  void Swap(SmallVector& other) noexcept(kNothrowMove) {
+    if (!IsInline() && !other.IsInline()) {
+      std::swap(buffer_, other.buffer_);
+      std::swap(size_, other.size_);
+      std::swap(capacity_, other.capacity_);
+    } else {
+      // Each heap buffer ends up next to the allocator that will free it once they are swapped.
+      SmallVector tmp(other.alloc_);
+      tmp.TakeFrom(other);
+      other.TakeFrom(*this);
+      TakeFrom(tmp);
+    }
+    if constexpr (AllocTraits::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
+  }
+  void Clear() noexcept(std::is_nothrow_destructible_v<ValueType>) {
+    ElementOps::Destroy(alloc_, buffer_, size_);
+    size_ = 0;
+  }
+  void Resize(size_t size) {
+    if (size <= size_) {
+      ElementOps::Destroy(alloc_, buffer_ + size, size_ - size);
+      size_ = size;
+      return;
+    }
+    if (size > capacity_) {
+      Reserve(GrowCapacity(size));
+    }
+    size_t count = size_;
+    try {
+      for (; count < size; ++count) {
+        AllocTraits::construct(alloc_, buffer_ + count);
+      }
+    } catch (...) {
+      ElementOps::Destroy(alloc_, buffer_ + size_, count - size_);
+      throw;
+    }
+    size_ = size;
+  }
+  void Resize(size_t size, const T& value) {
+    if (size <= size_) {
+      ElementOps::Destroy(alloc_, buffer_ + size, size_ - size);
+      size_ = size;
+      return;
+    }
+    if (size > capacity_) {
+      if (IsElement(value)) {
+        T copy(value);
+        Resize(size, copy);
+        return;
+      }
+      Reserve(GrowCapacity(size));
+    }
+    ElementOps::FillTo(alloc_, buffer_ + size_, size - size_, value);
+    size_ = size;
+  }
+  void Reserve(size_t capacity) {
+    if (capacity_ < capacity) {
+      MoveToBuffer(capacity);
+    }
+  }
+  // Moves the elements back into the inline storage when they fit.
+  void ShrinkToFit() {
+    if (IsInline() || size_ == capacity_) {
+      return;
+    }
+    if (size_ <= N) {
+      ElementOps::RelocateTo(alloc_, buffer_, size_, InlineBuffer());
+      AllocTraits::deallocate(alloc_, buffer_, capacity_);
+      buffer_ = InlineBuffer();
+      capacity_ = N;
+      return;
+    }
+    MoveToBuffer(size_);
+  }
+
+  template <class... Args>
+  void EmplaceBack(Args&&... args) {
+    if (size_ < capacity_) {
+      AllocTraits::construct(alloc_, buffer_ + size_, std::forward<Args>(args)...);
+      ++size_;
+      return;
+    }
+    auto [new_buff, new_capacity] = vector_detail::AllocateAtLeast(alloc_, GrowCapacity(size_ + 1));
+    try {
+      AllocTraits::construct(alloc_, new_buff + size_, std::forward<Args>(args)...);
+    } catch (...) {
+      AllocTraits::deallocate(alloc_, new_buff, new_capacity);
+      throw;
+    }
+    try {
+      ElementOps::RelocateTo(alloc_, buffer_, size_, new_buff);
+    } catch (...) {
+      AllocTraits::destroy(alloc_, new_buff + size_);
+      AllocTraits::deallocate(alloc_, new_buff, new_capacity);
+      throw;
+    }
+    ReleaseBuffer();
+    buffer_ = new_buff;
+    capacity_ = new_capacity;
+    ++size_;
+  }
+  void PushBack(const T& value) {
+    EmplaceBack(value);
+  }
+  void PushBack(T&& value) {
+    EmplaceBack(std::move(value));
+  }
+  void PopBack() noexcept(std::is_nothrow_destructible_v<ValueType>) {
+    if (!Empty()) {
+      --size_;
+      AllocTraits::destroy(alloc_, buffer_ + size_);
+    }
+  }
+
+  template <class... Args>
+  Iterator EmplaceAt(ConstIterator pos, Args&&... args) {
+    const auto idx = static_cast<size_t>(pos - cbegin());
+    PositionOps::EmplaceAt(*this, idx, std::forward<Args>(args)...);
+    return begin() + idx;
+  }
+  Iterator Insert(ConstIterator pos, const T& value) {
+    return EmplaceAt(pos, value);
+  }
+  Iterator Insert(ConstIterator pos, T&& value) {
+    return EmplaceAt(pos, std::move(value));
+  }
+  Iterator Insert(ConstIterator pos, size_t count, const T& value) {
+    const auto idx = static_cast<size_t>(pos - cbegin());
+    PositionOps::InsertFill(*this, idx, count, value);
+    return begin() + idx;
+  }
+  template <typename InputIterator, typename = EnableIfForwardIter<InputIterator>>
+  Iterator Insert(ConstIterator pos, InputIterator first, InputIterator last) {
+    const auto idx = static_cast<size_t>(pos - cbegin());
+    PositionOps::InsertRange(*this, idx, first, last);
+    return begin() + idx;
+  }
+  Iterator Insert(ConstIterator pos, std::initializer_list<T> init_lst) {
+    return Insert(pos, init_lst.begin(), init_lst.end());
+  }
+
+  Iterator Erase(ConstIterator pos) {
+    return Erase(pos, pos + 1);
+  }
+  // Same guarantees as Vector::Erase.
+  Iterator Erase(ConstIterator first, ConstIterator last) {
+    const auto idx = static_cast<size_t>(first - cbegin());
+    PositionOps::EraseRange(*this, idx, static_cast<size_t>(last - first));
+    return begin() + idx;
+  }
+
+  [[nodiscard]] ConstIterator cbegin() const noexcept {  // NOLINT
+    return Data();
+  }
+  [[nodiscard]] ConstIterator begin() const noexcept {  // NOLINT
+    return cbegin();
+  }
+  [[nodiscard]] Iterator begin() noexcept {  // NOLINT
+    return Data();
+  }
+  [[nodiscard]] ConstIterator cend() const noexcept {  // NOLINT
+    return Data() + size_;
+  }
+  [[nodiscard]] ConstIterator end() const noexcept {  // NOLINT
+    return cend();
+  }
+  [[nodiscard]] Iterator end() noexcept {  // NOLINT
+    return Data() + size_;
+  }
+  [[nodiscard]] ConstReverseIterator crbegin() const noexcept {  // NOLINT
+    return ConstReverseIterator(cend());
+  }
+  [[nodiscard]] ConstReverseIterator rbegin() const noexcept {  // NOLINT
+    return crbegin();
+  }
+  [[nodiscard]] ReverseIterator rbegin() noexcept {  // NOLINT
+    return ReverseIterator(end());
+  }
+  [[nodiscard]] ConstReverseIterator crend() const noexcept {  // NOLINT
+    return ConstReverseIterator(cbegin());
+  }
+  [[nodiscard]] ConstReverseIterator rend() const noexcept {  // NOLINT
+    return crend();
+  }
+  [[nodiscard]] ReverseIterator rend() noexcept {  // NOLINT
+    return ReverseIterator(begin());
+  }
+
+ private:
+  [[nodiscard]] Pointer InlineBuffer() noexcept {
+    return reinterpret_cast<Pointer>(inline_storage_);
+  }
+  [[nodiscard]] ConstPointer InlineBuffer() const noexcept {
+    return reinterpret_cast<ConstPointer>(inline_storage_);
+  }
+
+  [[nodiscard]] size_t GrowCapacity(size_t required) const {
+    return vector_detail::GrowCapacity<GrowthPolicy, T>(alloc_, capacity_, required);
+  }
+
+  [[nodiscard]] bool IsElement(const T& value) const noexcept {
+    return PositionOps::IsElement(buffer_, size_, value);
+  }
+
+  // Only called on an empty, inline SmallVector.
+  void AllocateExactly(size_t count) {
+    if (count > N) {
+      if (count > AllocTraits::max_size(alloc_)) {
+        throw std::length_error("");
+      }
+      buffer_ = AllocTraits::allocate(alloc_, count);
+      capacity_ = count;
+    }
+  }
+
+  void ReleaseBuffer() noexcept {
+    if (!IsInline()) {
+      AllocTraits::deallocate(alloc_, buffer_, capacity_);
+      buffer_ = InlineBuffer();
+      capacity_ = N;
+    }
+  }
+
+  void MoveToBuffer(size_t capacity) {
+    auto [new_buff, new_capacity] = vector_detail::AllocateAtLeast(alloc_, capacity);
+    try {
+      ElementOps::RelocateTo(alloc_, buffer_, size_, new_buff);
+    } catch (...) {
+      AllocTraits::deallocate(alloc_, new_buff, new_capacity);
+      throw;
+    }
+    ReleaseBuffer();
+    buffer_ = new_buff;
+    capacity_ = new_capacity;
+  }
+
+  // Moves other's elements one by one into storage from this allocator and leaves other empty.
+  // *this must be empty and inline.
+  void MoveElementsFrom(SmallVector& other) {
+    AllocateExactly(other.size_);
+    try {
+      ElementOps::CopyIterTo(alloc_, std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()),
+                             buffer_);
+    } catch (...) {
+      ReleaseBuffer();
+      throw;
+    }
+    size_ = other.size_;
+    other.Clear();
+  }
+
+  // Reallocation step of vector_detail::PositionOps.
+  template <typename Filler>
+  void ReallocateWith(size_t required, Filler&& fill) {
+    auto [new_buff, new_capacity] = vector_detail::AllocateAtLeast(alloc_, GrowCapacity(required));
+    try {
+      fill(new_buff);
+    } catch (...) {
+      AllocTraits::deallocate(alloc_, new_buff, new_capacity);
+      throw;
+    }
+    ReleaseBuffer();
+    buffer_ = new_buff;
+    capacity_ = new_capacity;
+  }
+
+  // Adopts the contents of other, which must use the same allocator, and leaves it empty.
+  // *this must be empty and inline.
+  void TakeFrom(SmallVector& other) noexcept(kNothrowMove) {
+    if (other.IsInline()) {
+      ElementOps::MoveIterTo(alloc_, other.begin(), other.end(), buffer_);
+      size_ = other.size_;
+      other.Clear();
+    } else {
+      buffer_ = std::exchange(other.buffer_, other.InlineBuffer());
+      size_ = std::exchange(other.size_, 0);
+      capacity_ = std::exchange(other.capacity_, N);
+    }
+  }
+
+ private:
+  Allocator alloc_{Allocator{}};
+  T* buffer_{nullptr};
+  size_t size_{0};
+  size_t capacity_{N};
+  alignas(T) unsigned char inline_storage_[N * sizeof(T)];
+};
+
+template <typename T, size_t N, class Alloc, class Growth>
+[[nodiscard]] bool operator==(const SmallVector<T, N, Alloc, Growth>& lhs,
+                              const SmallVector<T, N, Alloc, Growth>& rhs) noexcept {
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, size_t N, class Alloc, class Growth>
+[[nodiscard]] bool operator<(const SmallVector<T, N, Alloc, Growth>& lhs,
+                             const SmallVector<T, N, Alloc, Growth>& rhs) noexcept {
+  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, size_t N, class Alloc, class Growth>
+[[nodiscard]] bool operator!=(const SmallVector<T, N, Alloc, Growth>& lhs,
+                              const SmallVector<T, N, Alloc, Growth>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+template <typename T, size_t N, class Alloc, class Growth>
+[[nodiscard]] bool operator>(const SmallVector<T, N, Alloc, Growth>& lhs,
+                             const SmallVector<T, N, Alloc, Growth>& rhs) noexcept {
+  return rhs < lhs;
+}
+
+template <typename T, size_t N, class Alloc, class Growth>
+[[nodiscard]] bool operator<=(const SmallVector<T, N, Alloc, Growth>& lhs,
+                              const SmallVector<T, N, Alloc, Growth>& rhs) noexcept {
+  return !(lhs > rhs);
+}
+
+template <typename T, size_t N, class Alloc, class Growth>
+[[nodiscard]] bool operator>=(const SmallVector<T, N, Alloc, Growth>& lhs,
+                              const SmallVector<T, N, Alloc, Growth>& rhs) noexcept {
+  return !(lhs < rhs);
+}
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_SMALL_VECTOR_H_
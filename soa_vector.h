@@ -0,0 +1,539 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_SOA_VECTOR_H_
+#define OOP_ASSIGNMENTS_VECTOR_SOA_VECTOR_H_
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+#include "vector.h"
+#include "vector_view.h"
+
+namespace soa_vector_detail {
+
+inline constexpr size_t kColumnAlignment = 64;
+
+struct alignas(kColumnAlignment) Line {
+  unsigned char bytes[kColumnAlignment];
+};
+
+[[nodiscard]] constexpr size_t RoundUp(size_t bytes) noexcept {
+  return (bytes + kColumnAlignment - 1) / kColumnAlignment * kColumnAlignment;
+}
+
+}  // namespace soa_vector_detail
+
+// Structure-of-arrays vector: row k is (Data<0>()[k], Data<1>()[k], ...), and each field has
+// its own contiguous column starting on a cache line. All columns share one allocation and
+// grow together, so a loop over a few fields only streams those columns. Rows are accessed
+// through tuples of references, which is also what the iterators yield.
+template <typename... Fields>
+class SoAVector {
+  static_assert(sizeof...(Fields) != 0, "SoAVector needs at least one field");
+  static_assert(((alignof(Fields) <= soa_vector_detail::kColumnAlignment) && ...),
+                "fields may not be over-aligned beyond a cache line");
+
+  template <bool kConst>
+  class BasicIterator;
+
+ public:
+  using ValueType = std::tuple<Fields...>;
+  using Reference = std::tuple<Fields&...>;
+  using ConstReference = std::tuple<const Fields&...>;
+  using SizeType = size_t;
+  using Iterator = BasicIterator<false>;
+  using ConstIterator = BasicIterator<true>;
+
+  template <size_t I>
+  using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+  static constexpr size_t kFieldCount = sizeof...(Fields);
+
+  SoAVector() noexcept = default;
+  explicit SoAVector(size_t size) : SoAVector() {
+    Resize(size);
+  }
+  SoAVector(const SoAVector& other) : SoAVector() {
+    Reserve(other.size_);
+    ForEachColumn([&](auto column) {
+      constexpr size_t kI = decltype(column)::value;
+      try {
+        Ops<kI>::CopyIterTo(Alloc<kI>(), other.Data<kI>(), other.Data<kI>() + other.size_, Data<kI>());
+      } catch (...) {
+        DestroyColumns<kI>(0, other.size_);
+        throw;
+      }
+    });
+    size_ = other.size_;
+  }
+  SoAVector(SoAVector&& other) noexcept
+      : lines_(std::exchange(other.lines_, nullptr))
+      , columns_(std::exchange(other.columns_, {}))
+      , size_(std::exchange(other.size_, 0))
+      , capacity_(std::exchange(other.capacity_, 0)) {
+  }
+
+  SoAVector& operator=(const SoAVector& other) {
+    if (this != &other) {
+      SoAVector copy(other);
+      Swap(copy);
+    }
+    return *this;
+  }
+  SoAVector& operator=(SoAVector&& other) noexcept {
+    if (this != &other) {
+      SoAVector moved(std::move(other));
+      Swap(moved);
+    }
+    return *this;
+  }
+
+  ~SoAVector() {
+    Clear();
+    Deallocate();
+  }
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return size_;
+  }
+  [[nodiscard]] SizeType Capacity() const noexcept {
+    return capacity_;
+  }
+  [[nodiscard]] bool Empty() const noexcept {
+    return size_ == 0;
+  }
+
+  // Column I, aligned to a cache line.
+  template <size_t I>
+  [[nodiscard]] const FieldType<I>* Data() const noexcept {
+    return std::get<I>(columns_);
+  }
+  template <size_t I>
+  [[nodiscard]] FieldType<I>* Data() noexcept {
+    return std::get<I>(columns_);
+  }
+  template <size_t I>
+  [[nodiscard]] ConstVectorView<FieldType<I>> Column() const noexcept {
+    return {Data<I>(), size_};
+  }
+  template <size_t I>
+  [[nodiscard]] VectorView<FieldType<I>> Column() noexcept {
+    return {Data<I>(), size_};
+  }
+
+  [[nodiscard]] ConstReference operator[](size_t idx) const noexcept {
+    return MakeRow<ConstReference>(*this, idx, std::index_sequence_for<Fields...>());
+  }
+  [[nodiscard]] Reference operator[](size_t idx) noexcept {
+    return MakeRow<Reference>(*this, idx, std::index_sequence_for<Fields...>());
+  }
+  [[nodiscard]] ConstReference At(size_t idx) const {
+    if (idx >= size_) {
+      throw std::out_of_range("");
+    }
+    return (*this)[idx];
+  }
+  [[nodiscard]] Reference At(size_t idx) {
+    if (idx >= size_) {
+      throw std::out_of_range("");
+    }
+    return (*this)[idx];
+  }
+  [[nodiscard]] ConstReference Front() const noexcept {
+    return (*this)[0];
+  }
+  [[nodiscard]] Reference Front() noexcept {
+    return (*this)[0];
+  }
+  [[nodiscard]] ConstReference Back() const noexcept {
+    return (*this)[size_ - 1];
+  }
+  [[nodiscard]] Reference Back() noexcept {
+    return (*this)[size_ - 1];
+  }
+
+  void Swap(SoAVector& other) noexcept {
+    std::swap(lines_, other.lines_);
+    std::swap(columns_, other.columns_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+  }
+  void Clear() noexcept {
+    ForEachColumn([&](auto column) {
+      constexpr size_t kI = decltype(column)::value;
+      Ops<kI>::Destroy(Alloc<kI>(), Data<kI>(), size_);
+    });
+    size_ = 0;
+  }
+  // New rows are value-initialized.
+  void Resize(size_t size) {
+    if (size <= size_) {
+      ForEachColumn([&](auto column) {
+        constexpr size_t kI = decltype(column)::value;
+        Ops<kI>::Destroy(Alloc<kI>(), Data<kI>() + size, size_ - size);
+      });
+      size_ = size;
+      return;
+    }
+    if (size > capacity_) {
+      Reallocate(GrowCapacity(size));
+    }
+    const size_t count = size - size_;
+    ForEachColumn([&](auto column) {
+      constexpr size_t kI = decltype(column)::value;
+      try {
+        Ops<kI>::ValueInitTo(Alloc<kI>(), Data<kI>() + size_, count);
+      } catch (...) {
+        DestroyColumns<kI>(size_, count);
+        throw;
+      }
+    });
+    size_ = size;
+  }
+  void Reserve(size_t capacity) {
+    if (capacity > capacity_) {
+      Reallocate(capacity);
+    }
+  }
+  void ShrinkToFit() {
+    if (size_ == 0) {
+      Deallocate();
+      lines_ = nullptr;
+      columns_ = {};
+      capacity_ = 0;
+    } else if (size_ != capacity_) {
+      Reallocate(size_);
+    }
+  }
+
+  // Builds field I of the new row from the I-th argument. The arguments may refer to fields of
+  // existing rows.
+  template <class... Args>
+  void EmplaceBack(Args&&... args) {
+    static_assert(sizeof...(Args) == kFieldCount, "EmplaceBack takes one argument per field");
+    if (size_ < capacity_) {
+      ConstructRow(columns_, size_, std::forward<Args>(args)...);
+    } else {
+      SoAVector grown;
+      grown.Allocate(GrowCapacity(size_ + 1));
+      ConstructRow(grown.columns_, size_, std::forward<Args>(args)...);
+      try {
+        RelocateTo(grown.columns_);
+      } catch (...) {
+        grown.DestroyRange(size_, size_ + 1);
+        throw;
+      }
+      std::swap(lines_, grown.lines_);
+      std::swap(columns_, grown.columns_);
+      std::swap(capacity_, grown.capacity_);
+    }
+    ++size_;
+  }
+  void PushBack(const Fields&... values) {
+    EmplaceBack(values...);
+  }
+  void PopBack() noexcept {
+    if (!Empty()) {
+      --size_;
+      DestroyRange(size_, size_ + 1);
+    }
+  }
+
+  Iterator Erase(ConstIterator pos) {
+    return Erase(pos, pos + 1);
+  }
+  // Basic guarantee if a move assignment throws.
+  Iterator Erase(ConstIterator first, ConstIterator last) {
+    const auto idx = static_cast<size_t>(first - cbegin());
+    const auto count = static_cast<size_t>(last - first);
+    if (count != 0) {
+      ForEachColumn([&](auto column) {
+        constexpr size_t kI = decltype(column)::value;
+        std::move(Data<kI>() + idx + count, Data<kI>() + size_, Data<kI>() + idx);
+      });
+      DestroyRange(size_ - count, size_);
+      size_ -= count;
+    }
+    return begin() + idx;
+  }
+
+  [[nodiscard]] ConstIterator cbegin() const noexcept {  // NOLINT
+    return ConstIterator(this, 0);
+  }
+  [[nodiscard]] ConstIterator begin() const noexcept {  // NOLINT
+    return cbegin();
+  }
+  [[nodiscard]] Iterator begin() noexcept {  // NOLINT
+    return Iterator(this, 0);
+  }
+  [[nodiscard]] ConstIterator cend() const noexcept {  // NOLINT
+    return ConstIterator(this, size_);
+  }
+  [[nodiscard]] ConstIterator end() const noexcept {  // NOLINT
+    return cend();
+  }
+  [[nodiscard]] Iterator end() noexcept {  // NOLINT
+    return Iterator(this, size_);
+  }
+
+ private:
+  using Columns = std::tuple<Fields*...>;
+
+  template <size_t I>
+  using Ops = vector_detail::ElementOps<FieldType<I>, std::allocator<FieldType<I>>>;
+
+  template <size_t I>
+  [[nodiscard]] static std::allocator<FieldType<I>>& Alloc() noexcept {
+    static std::allocator<FieldType<I>> alloc;
+    return alloc;
+  }
+
+  static constexpr size_t kRowBytes = (sizeof(Fields) + ...);
+
+  // Columns whose relocation can throw: their elements are neither memcpy-relocated nor moved
+  // by a noexcept move constructor.
+  template <size_t I>
+  static constexpr bool kThrowingRelocation =
+      !Ops<I>::kBulkRelocation && !std::is_nothrow_move_constructible_v<FieldType<I>>;
+
+  // Random-access iterator over rows whose reference is a tuple of field references.
+  template <bool kConst>
+  class BasicIterator {
+    using Owner = std::conditional_t<kConst, const SoAVector, SoAVector>;
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;  // NOLINT
+    using value_type = ValueType;  // NOLINT
+    using difference_type = ptrdiff_t;  // NOLINT
+    using reference = std::conditional_t<kConst, ConstReference, Reference>;  // NOLINT
+    using pointer = void;  // NOLINT
+
+    BasicIterator() noexcept = default;
+    template <bool kOtherConst, typename = std::enable_if_t<kConst && !kOtherConst>>
+    BasicIterator(const BasicIterator<kOtherConst>& other) noexcept  // NOLINT
+        : owner_(other.owner_), idx_(other.idx_) {
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {
+      return (*owner_)[idx_];
+    }
+    [[nodiscard]] reference operator[](difference_type n) const noexcept {
+      return (*owner_)[idx_ + n];
+    }
+    // Index of the row, for reaching its fields through Data<I>().
+    [[nodiscard]] size_t Index() const noexcept {
+      return idx_;
+    }
+
+    BasicIterator& operator++() noexcept {
+      ++idx_;
+      return *this;
+    }
+    BasicIterator operator++(int) noexcept {
+      auto copy = *this;
+      ++idx_;
+      return copy;
+    }
+    BasicIterator& operator--() noexcept {
+      --idx_;
+      return *this;
+    }
+    BasicIterator operator--(int) noexcept {
+      auto copy = *this;
+      --idx_;
+      return copy;
+    }
+    BasicIterator& operator+=(difference_type n) noexcept {
+      idx_ += n;
+      return *this;
+    }
+    BasicIterator& operator-=(difference_type n) noexcept {
+      idx_ -= n;
+      return *this;
+    }
+    [[nodiscard]] friend BasicIterator operator+(BasicIterator it, difference_type n) noexcept {
+      return it += n;
+    }
+    [[nodiscard]] friend BasicIterator operator+(difference_type n, BasicIterator it) noexcept {
+      return it += n;
+    }
+    [[nodiscard]] friend BasicIterator operator-(BasicIterator it, difference_type n) noexcept {
+      return it -= n;
+    }
+    [[nodiscard]] friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return static_cast<difference_type>(lhs.idx_ - rhs.idx_);
+    }
+
+    [[nodiscard]] friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return lhs.idx_ == rhs.idx_;
+    }
+    [[nodiscard]] friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return lhs.idx_ != rhs.idx_;
+    }
+    [[nodiscard]] friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return lhs.idx_ < rhs.idx_;
+    }
+    [[nodiscard]] friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return rhs < lhs;
+    }
+    [[nodiscard]] friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return !(rhs < lhs);
+    }
+    [[nodiscard]] friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+      return !(lhs < rhs);
+    }
+
+   private:
+    friend class SoAVector;
+    template <bool>
+    friend class BasicIterator;
+
+    BasicIterator(Owner* owner, size_t idx) noexcept : owner_(owner), idx_(idx) {
+    }
+
+    Owner* owner_{nullptr};
+    size_t idx_{0};
+  };
+
+  template <class RowReference, class Owner, size_t... Is>
+  [[nodiscard]] static RowReference MakeRow(Owner& owner, size_t idx, std::index_sequence<Is...>) noexcept {
+    return RowReference(owner.template Data<Is>()[idx]...);
+  }
+
+  template <class Body, size_t... Is>
+  static void ForEachColumnImpl(Body& body, std::index_sequence<Is...>) {
+    (body(std::integral_constant<size_t, Is>()), ...);
+  }
+  template <class Body>
+  static void ForEachColumn(Body&& body) {
+    ForEachColumnImpl(body, std::index_sequence_for<Fields...>());
+  }
+
+  [[nodiscard]] static constexpr size_t MaxCapacity() noexcept {
+    return (std::numeric_limits<size_t>::max() / 2 - kFieldCount * soa_vector_detail::kColumnAlignment) / kRowBytes;
+  }
+
+  [[nodiscard]] static size_t TotalBytes(size_t capacity) noexcept {
+    return (soa_vector_detail::RoundUp(sizeof(Fields) * capacity) + ...);
+  }
+
+  [[nodiscard]] size_t GrowCapacity(size_t required) const {
+    if (required > MaxCapacity()) {
+      throw std::length_error("");
+    }
+    return std::min(DoublingGrowth::NextCapacity(capacity_, required, kRowBytes), MaxCapacity());
+  }
+
+  // Sets up empty columns for `capacity` rows in one allocation.
+  void Allocate(size_t capacity) {
+    if (capacity > MaxCapacity()) {
+      throw std::length_error("");
+    }
+    std::allocator<soa_vector_detail::Line> alloc;
+    lines_ = alloc.allocate(TotalBytes(capacity) / soa_vector_detail::kColumnAlignment);
+    capacity_ = capacity;
+    auto* bytes = reinterpret_cast<unsigned char*>(lines_);
+    ForEachColumn([&](auto column) {
+      constexpr size_t kI = decltype(column)::value;
+      std::get<kI>(columns_) = reinterpret_cast<FieldType<kI>*>(bytes);
+      bytes += soa_vector_detail::RoundUp(sizeof(FieldType<kI>) * capacity);
+    });
+  }
+
+  void Deallocate() noexcept {
+    if (lines_ != nullptr) {
+      std::allocator<soa_vector_detail::Line>().deallocate(
+          lines_, TotalBytes(capacity_) / soa_vector_detail::kColumnAlignment);
+    }
+  }
+
+  void Reallocate(size_t capacity) {
+    SoAVector grown;
+    grown.Allocate(capacity);
+    RelocateTo(grown.columns_);
+    std::swap(lines_, grown.lines_);
+    std::swap(columns_, grown.columns_);
+    std::swap(capacity_, grown.capacity_);
+  }
+
+  // Moves the rows into `to` and ends their lifetime here. Columns that could throw are
+  // transferred first, so that when one fails the other columns are still in place; the rest
+  // are relocated afterwards, which cannot throw. Strong guarantee unless a field type is
+  // move-only with a throwing move constructor.
+  void RelocateTo(const Columns& to) {
+    ForEachColumn([&](auto column) {
+      constexpr size_t kI = decltype(column)::value;
+      if constexpr (kThrowingRelocation<kI>) {
+        try {
+          Ops<kI>::MoveIterTo(Alloc<kI>(), Data<kI>(), Data<kI>() + size_, std::get<kI>(to));
+        } catch (...) {
+          DestroyThrowingColumns<kI>(to);
+          throw;
+        }
+      }
+    });
+    ForEachColumn([&](auto column) {
+      constexpr size_t kI = decltype(column)::value;
+      if constexpr (kThrowingRelocation<kI>) {
+        Ops<kI>::Destroy(Alloc<kI>(), Data<kI>(), size_);
+      } else {
+        Ops<kI>::RelocateTo(Alloc<kI>(), Data<kI>(), size_, std::get<kI>(to));
+      }
+    });
+  }
+
+  // Cleanup for RelocateTo: destroys the copies made in `to` by the columns before kEnd.
+  template <size_t kEnd>
+  void DestroyThrowingColumns(const Columns& to) noexcept {
+    ForEachColumn([&](auto column) {
+      constexpr size_t kI = decltype(column)::value;
+      if constexpr (kI < kEnd && kThrowingRelocation<kI>) {
+        Ops<kI>::Destroy(Alloc<kI>(), std::get<kI>(to), size_);
+      }
+    });
+  }
+
+  // Destroys count rows starting at `first` in the columns before kEnd.
+  template <size_t kEnd>
+  void DestroyColumns(size_t first, size_t count) noexcept {
+    ForEachColumn([&](auto column) {
+      constexpr size_t kI = decltype(column)::value;
+      if constexpr (kI < kEnd) {
+        Ops<kI>::Destroy(Alloc<kI>(), Data<kI>() + first, count);
+      }
+    });
+  }
+
+  void DestroyRange(size_t first, size_t last) noexcept {
+    ForEachColumn([&](auto column) {
+      constexpr size_t kI = decltype(column)::value;
+      Ops<kI>::Destroy(Alloc<kI>(), Data<kI>() + first, last - first);
+    });
+  }
+
+  template <class... Args>
+  static void ConstructRow(const Columns& columns, size_t idx, Args&&... args) {
+    ConstructFields<0>(columns, idx, std::forward<Args>(args)...);
+  }
+  template <size_t I, class Arg, class... Rest>
+  static void ConstructFields(const Columns& columns, size_t idx, Arg&& arg, Rest&&... rest) {
+    FieldType<I>* slot = std::get<I>(columns) + idx;
+    std::allocator_traits<std::allocator<FieldType<I>>>::construct(Alloc<I>(), slot, std::forward<Arg>(arg));
+    if constexpr (sizeof...(Rest) != 0) {
+      try {
+        ConstructFields<I + 1>(columns, idx, std::forward<Rest>(rest)...);
+      } catch (...) {
+        std::allocator_traits<std::allocator<FieldType<I>>>::destroy(Alloc<I>(), slot);
+        throw;
+      }
+    }
+  }
+
+  soa_vector_detail::Line* lines_{nullptr};
+  Columns columns_{};
+  size_t size_{0};
+  size_t capacity_{0};
+};
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_SOA_VECTOR_H_
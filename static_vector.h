@@ -0,0 +1,366 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_STATIC_VECTOR_H_
+#define OOP_ASSIGNMENTS_VECTOR_STATIC_VECTOR_H_
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace static_vector_detail {
+
+// The narrowest unsigned type that holds every size up to N.
+template <size_t N>
+using SizeFor = std::conditional_t<
+    N <= UINT8_MAX, uint8_t,
+    std::conditional_t<N <= UINT16_MAX, uint16_t, std::conditional_t<N <= UINT32_MAX, uint32_t, size_t>>>;
+
+}  // namespace static_vector_detail
+
+// Vector with room for N elements inside the object: no allocator, no heap, and nothing to keep
+// but the size. Appending past N throws std::length_error. It is usable in constant
+// expressions, and for trivial T also as the type of a constexpr variable, so that bounded
+// tables can be built at compile time. It is trivially copyable and destructible when T is.
+template <typename T, size_t N>
+class StaticVector {
+  static_assert(N != 0, "StaticVector needs a capacity");
+
+  static constexpr bool kTrivial = std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>;
+  static constexpr bool kNothrowMove = std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>;
+
+ public:
+  using ValueType = T;
+  using SizeType = size_t;
+  using DifferenceType = ptrdiff_t;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using Pointer = T*;
+  using ConstPointer = const T*;
+  using Iterator = Pointer;
+  using ConstIterator = ConstPointer;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+ private:
+  template <class Iter>
+  using EnableIfForwardIter = std::enable_if_t<
+      std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>>;
+
+ public:
+  // Constant evaluation only accepts a constexpr variable whose every element is initialized,
+  // so trivial elements are all built up front there.
+  constexpr StaticVector() noexcept {
+    if constexpr (kTrivial) {
+      if (std::is_constant_evaluated()) {
+        for (size_t i = 0; i < N; i++) {
+          std::construct_at(data_ + i);
+        }
+      }
+    }
+  }
+  explicit constexpr StaticVector(size_t size) : StaticVector() {
+    Resize(size);
+  }
+  constexpr StaticVector(size_t size, const T& value) : StaticVector() {
+    Resize(size, value);
+  }
+  constexpr StaticVector(std::initializer_list<T> init_lst) : StaticVector(init_lst.begin(), init_lst.end()) {
+  }
+  template <typename InputIterator, typename = EnableIfForwardIter<InputIterator>>
+  constexpr StaticVector(InputIterator first, InputIterator last) : StaticVector() {
+    CheckRoom(static_cast<size_t>(std::distance(first, last)));
+    for (; first != last; ++first) {
+      UncheckedEmplaceBack(*first);
+    }
+  }
+
+  constexpr StaticVector(const StaticVector& other) requires std::is_trivially_copyable_v<T> = default;
+  constexpr StaticVector(const StaticVector& other) : StaticVector(other.begin(), other.end()) {
+  }
+  constexpr StaticVector(StaticVector&& other) noexcept requires std::is_trivially_copyable_v<T> = default;
+  constexpr StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : StaticVector() {
+    for (auto& element : other) {
+      UncheckedEmplaceBack(std::move(element));
+    }
+  }
+
+  constexpr StaticVector& operator=(const StaticVector& other) requires std::is_trivially_copyable_v<T> = default;
+  // Assigns over the common prefix; basic guarantee if an element assignment or copy throws.
+  constexpr StaticVector& operator=(const StaticVector& other) {
+    if (this != &other) {
+      AssignFrom(other.data_, other.size_);
+    }
+    return *this;
+  }
+  constexpr StaticVector& operator=(StaticVector&& other) noexcept requires std::is_trivially_copyable_v<T> = default;
+  constexpr StaticVector& operator=(StaticVector&& other) noexcept(kNothrowMove) {
+    if (this != &other) {
+      AssignFrom(std::make_move_iterator(other.data_), other.size_);
+    }
+    return *this;
+  }
+
+  constexpr ~StaticVector() requires std::is_trivially_destructible_v<T> = default;
+  constexpr ~StaticVector() {
+    Truncate(0);
+  }
+
+  [[nodiscard]] constexpr SizeType Size() const noexcept {
+    return size_;
+  }
+  [[nodiscard]] static constexpr SizeType Capacity() noexcept {
+    return N;
+  }
+  [[nodiscard]] constexpr bool Empty() const noexcept {
+    return size_ == 0;
+  }
+  [[nodiscard]] constexpr bool Full() const noexcept {
+    return size_ == N;
+  }
+  [[nodiscard]] constexpr ConstReference Front() const noexcept {
+    return data_[0];
+  }
+  [[nodiscard]] constexpr Reference Front() noexcept {
+    return data_[0];
+  }
+  [[nodiscard]] constexpr ConstReference Back() const noexcept {
+    return data_[size_ - 1];
+  }
+  [[nodiscard]] constexpr Reference Back() noexcept {
+    return data_[size_ - 1];
+  }
+  [[nodiscard]] constexpr ConstReference At(size_t idx) const {
+    if (idx >= size_) {
+      throw std::out_of_range("");
+    }
+    return data_[idx];
+  }
+  [[nodiscard]] constexpr Reference At(size_t idx) {
+    return const_cast<Reference>(const_cast<const StaticVector&>(*this).At(idx));
+  }
+  [[nodiscard]] constexpr ConstPointer Data() const noexcept {
+    return data_;
+  }
+  [[nodiscard]] constexpr Pointer Data() noexcept {
+    return data_;
+  }
+  [[nodiscard]] constexpr ConstReference operator[](size_t idx) const noexcept {
+    return data_[idx];
+  }
+  [[nodiscard]] constexpr Reference operator[](size_t idx) noexcept {
+    return data_[idx];
+  }
+
+  // Basic guarantee if a move throws.
+  constexpr void Swap(StaticVector& other) noexcept(kNothrowMove && std::is_nothrow_swappable_v<T>) {
+    const size_t common = std::min<size_t>(size_, other.size_);
+    std::swap_ranges(data_, data_ + common, other.data_);
+    StaticVector& longer = size_ < other.size_ ? other : *this;
+    StaticVector& shorter = size_ < other.size_ ? *this : other;
+    for (size_t i = common; i < longer.size_; i++) {
+      shorter.UncheckedEmplaceBack(std::move(longer.data_[i]));
+    }
+    longer.Truncate(common);
+  }
+
+  constexpr void Clear() noexcept(std::is_nothrow_destructible_v<T>) {
+    Truncate(0);
+  }
+  // Growth has the strong guarantee.
+  constexpr void Resize(size_t size) {
+    ResizeWith(size, [](Pointer slot) { std::construct_at(slot); });
+  }
+  constexpr void Resize(size_t size, const T& value) {
+    ResizeWith(size, [&](Pointer slot) { std::construct_at(slot, value); });
+  }
+
+  template <class... Args>
+  constexpr void EmplaceBack(Args&&... args) {
+    CheckRoom(1);
+    UncheckedEmplaceBack(std::forward<Args>(args)...);
+  }
+  // For callers that know there is room: no check outside of debug builds.
+  template <class... Args>
+  constexpr void UncheckedEmplaceBack(Args&&... args) {
+    assert(size_ < N);
+    std::construct_at(data_ + size_, std::forward<Args>(args)...);
+    ++size_;
+  }
+  constexpr void PushBack(const T& value) {
+    EmplaceBack(value);
+  }
+  constexpr void PushBack(T&& value) {
+    EmplaceBack(std::move(value));
+  }
+  constexpr void UncheckedPushBack(const T& value) {
+    UncheckedEmplaceBack(value);
+  }
+  constexpr void UncheckedPushBack(T&& value) {
+    UncheckedEmplaceBack(std::move(value));
+  }
+  constexpr void PopBack() noexcept(std::is_nothrow_destructible_v<T>) {
+    if (!Empty()) {
+      Truncate(size_ - 1);
+    }
+  }
+
+  // Built at the end and rotated into place: basic guarantee if a move throws.
+  template <class... Args>
+  constexpr Iterator EmplaceAt(ConstIterator pos, Args&&... args) {
+    const auto idx = static_cast<size_t>(pos - cbegin());
+    EmplaceBack(std::forward<Args>(args)...);
+    std::rotate(begin() + idx, end() - 1, end());
+    return begin() + idx;
+  }
+  constexpr Iterator Insert(ConstIterator pos, const T& value) {
+    return EmplaceAt(pos, value);
+  }
+  constexpr Iterator Insert(ConstIterator pos, T&& value) {
+    return EmplaceAt(pos, std::move(value));
+  }
+
+  constexpr Iterator Erase(ConstIterator pos) {
+    return Erase(pos, pos + 1);
+  }
+  constexpr Iterator Erase(ConstIterator first, ConstIterator last) {
+    const auto idx = static_cast<size_t>(first - cbegin());
+    const auto count = static_cast<size_t>(last - first);
+    if (count != 0) {
+      std::move(begin() + idx + count, end(), begin() + idx);
+      Truncate(size_ - count);
+    }
+    return begin() + idx;
+  }
+
+  [[nodiscard]] constexpr ConstIterator cbegin() const noexcept {  // NOLINT
+    return data_;
+  }
+  [[nodiscard]] constexpr ConstIterator begin() const noexcept {  // NOLINT
+    return cbegin();
+  }
+  [[nodiscard]] constexpr Iterator begin() noexcept {  // NOLINT
+    return data_;
+  }
+  [[nodiscard]] constexpr ConstIterator cend() const noexcept {  // NOLINT
+    return data_ + size_;
+  }
+  [[nodiscard]] constexpr ConstIterator end() const noexcept {  // NOLINT
+    return cend();
+  }
+  [[nodiscard]] constexpr Iterator end() noexcept {  // NOLINT
+    return data_ + size_;
+  }
+  [[nodiscard]] constexpr ConstReverseIterator crbegin() const noexcept {  // NOLINT
+    return ConstReverseIterator(cend());
+  }
+  [[nodiscard]] constexpr ConstReverseIterator rbegin() const noexcept {  // NOLINT
+    return crbegin();
+  }
+  [[nodiscard]] constexpr ReverseIterator rbegin() noexcept {  // NOLINT
+    return ReverseIterator(end());
+  }
+  [[nodiscard]] constexpr ConstReverseIterator crend() const noexcept {  // NOLINT
+    return ConstReverseIterator(cbegin());
+  }
+  [[nodiscard]] constexpr ConstReverseIterator rend() const noexcept {  // NOLINT
+    return crend();
+  }
+  [[nodiscard]] constexpr ReverseIterator rend() noexcept {  // NOLINT
+    return ReverseIterator(begin());
+  }
+
+ private:
+  constexpr void CheckRoom(size_t count) const {
+    if (count > N - size_) {
+      throw std::length_error("");
+    }
+  }
+
+  constexpr void Truncate(size_t size) noexcept(std::is_nothrow_destructible_v<T>) {
+    for (size_t i = size; i < size_; i++) {
+      std::destroy_at(data_ + i);
+    }
+    size_ = static_cast<static_vector_detail::SizeFor<N>>(size);
+  }
+
+  template <typename Builder>
+  constexpr void ResizeWith(size_t size, Builder&& build) {
+    if (size <= size_) {
+      Truncate(size);
+      return;
+    }
+    CheckRoom(size - size_);
+    const size_t old_size = size_;
+    try {
+      while (size_ < size) {
+        build(data_ + size_);
+        ++size_;
+      }
+    } catch (...) {
+      Truncate(old_size);
+      throw;
+    }
+  }
+
+  template <typename Iter>
+  constexpr void AssignFrom(Iter from, size_t count) {
+    const size_t common = std::min<size_t>(size_, count);
+    std::copy(from, from + common, data_);
+    if (count < size_) {
+      Truncate(count);
+    }
+    for (size_t i = common; i < count; i++) {
+      UncheckedEmplaceBack(from[i]);
+    }
+  }
+
+  union {
+    T data_[N];
+  };
+  static_vector_detail::SizeFor<N> size_{0};
+};
+
+// Removes the elements satisfying pred in a single compacting pass and returns their number.
+template <typename T, size_t N, class Predicate>
+constexpr size_t EraseIf(StaticVector<T, N>& vec, Predicate pred) {
+  auto new_end = std::remove_if(vec.begin(), vec.end(), pred);
+  const auto count = static_cast<size_t>(vec.end() - new_end);
+  vec.Erase(new_end, vec.end());
+  return count;
+}
+
+template <typename T, size_t N>
+[[nodiscard]] constexpr bool operator==(const StaticVector<T, N>& lhs, const StaticVector<T, N>& rhs) noexcept {
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, size_t N>
+[[nodiscard]] constexpr bool operator<(const StaticVector<T, N>& lhs, const StaticVector<T, N>& rhs) noexcept {
+  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, size_t N>
+[[nodiscard]] constexpr bool operator!=(const StaticVector<T, N>& lhs, const StaticVector<T, N>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+template <typename T, size_t N>
+[[nodiscard]] constexpr bool operator>(const StaticVector<T, N>& lhs, const StaticVector<T, N>& rhs) noexcept {
+  return rhs < lhs;
+}
+
+template <typename T, size_t N>
+[[nodiscard]] constexpr bool operator<=(const StaticVector<T, N>& lhs, const StaticVector<T, N>& rhs) noexcept {
+  return !(lhs > rhs);
+}
+
+template <typename T, size_t N>
+[[nodiscard]] constexpr bool operator>=(const StaticVector<T, N>& lhs, const StaticVector<T, N>& rhs) noexcept {
+  return !(lhs < rhs);
+}
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_STATIC_VECTOR_H_
@@ -0,0 +1,209 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_THREAD_POOL_H_
+#define OOP_ASSIGNMENTS_VECTOR_THREAD_POOL_H_
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "vector.h"
+
+// Fixed set of worker threads with one task queue each. Workers take their own tasks newest
+// first and steal the oldest tasks of other queues when they run dry; a thread waiting in Run
+// executes tasks as well, so Run may be called from inside a task.
+class ThreadPool {
+ public:
+  explicit ThreadPool(size_t workers = DefaultWorkers())
+      : queues_(std::make_unique<Queue[]>(workers + 1)), queue_count_(workers + 1) {
+    workers_.Reserve(workers);
+    try {
+      for (size_t i = 0; i < workers; ++i) {
+        workers_.EmplaceBack([this, i] { WorkerLoop(i + 1); });
+      }
+    } catch (...) {
+      Stop();
+      throw;
+    }
+  }
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool() {
+    Stop();
+  }
+
+  // Shared pool with a worker for every hardware thread but the caller's.
+  [[nodiscard]] static ThreadPool& Default() {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  [[nodiscard]] static size_t DefaultWorkers() noexcept {
+    const size_t threads = std::thread::hardware_concurrency();
+    return threads > 1 ? threads - 1 : 0;
+  }
+
+  // Threads that execute tasks of a Run, including the calling one.
+  [[nodiscard]] size_t Concurrency() const noexcept {
+    return workers_.Size() + 1;
+  }
+
+  // Calls task(k) for every k in [0, count) and returns when all calls have finished. If some
+  // throw, the others still run and the first exception is rethrown.
+  template <class Task>
+  void Run(size_t count, Task&& task) {
+    if (count == 0) {
+      return;
+    }
+    if (workers_.Empty() || count == 1) {
+      std::exception_ptr error;
+      for (size_t k = 0; k < count; ++k) {
+        try {
+          task(k);
+        } catch (...) {
+          if (!error) {
+            error = std::current_exception();
+          }
+        }
+      }
+      if (error) {
+        std::rethrow_exception(error);
+      }
+      return;
+    }
+    Batch batch{&Invoke<std::remove_reference_t<Task>>, std::addressof(task), count};
+    {
+      // Counted before they are queued, so that the count never drops below zero.
+      std::lock_guard lock(sleep_mutex_);
+      queued_.fetch_add(count, std::memory_order_release);
+    }
+    // Contiguous runs of tasks per worker keep neighbouring chunks on one thread until stolen.
+    const size_t workers = workers_.Size();
+    size_t next = 0;
+    try {
+      for (size_t w = 0; w < workers; ++w) {
+        Queue& queue = queues_[w + 1];
+        std::lock_guard lock(queue.mutex);
+        for (; next < count * (w + 1) / workers; ++next) {
+          queue.jobs.push_back({&batch, next});
+        }
+      }
+    } catch (...) {
+      // Out of memory for the queues: the tasks that were not queued run here.
+      queued_.fetch_sub(count - next, std::memory_order_relaxed);
+      for (; next < count; ++next) {
+        Execute({&batch, next});
+      }
+    }
+    wake_.notify_all();
+    while (batch.pending.load(std::memory_order_acquire) != 0) {
+      if (!TryRunOne(current_queue_)) {
+        std::this_thread::yield();
+      }
+    }
+    if (batch.error) {
+      std::rethrow_exception(batch.error);
+    }
+  }
+
+ private:
+  struct Batch {
+    void (*invoke)(void* task, size_t k);
+    void* task;
+    std::atomic<size_t> pending;
+    std::mutex error_mutex{};
+    std::exception_ptr error{};
+  };
+
+  struct Job {
+    Batch* batch;
+    size_t index;
+  };
+
+  struct alignas(64) Queue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  template <class Task>
+  static void Invoke(void* task, size_t k) {
+    (*static_cast<Task*>(task))(k);
+  }
+
+  static void Execute(const Job& job) noexcept {
+    Batch& batch = *job.batch;
+    try {
+      batch.invoke(batch.task, job.index);
+    } catch (...) {
+      std::lock_guard lock(batch.error_mutex);
+      if (!batch.error) {
+        batch.error = std::current_exception();
+      }
+    }
+    batch.pending.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  bool TryRunOne(size_t home) {
+    for (size_t i = 0; i < queue_count_; ++i) {
+      Queue& queue = queues_[(home + i) % queue_count_];
+      std::unique_lock lock(queue.mutex);
+      if (queue.jobs.empty()) {
+        continue;
+      }
+      Job job;
+      if (i == 0) {
+        job = queue.jobs.back();
+        queue.jobs.pop_back();
+      } else {
+        job = queue.jobs.front();
+        queue.jobs.pop_front();
+      }
+      lock.unlock();
+      queued_.fetch_sub(1, std::memory_order_relaxed);
+      Execute(job);
+      return true;
+    }
+    return false;
+  }
+
+  void WorkerLoop(size_t home) {
+    current_queue_ = home;
+    while (true) {
+      if (TryRunOne(home)) {
+        continue;
+      }
+      std::unique_lock lock(sleep_mutex_);
+      wake_.wait(lock, [this] { return stop_ || queued_.load(std::memory_order_acquire) != 0; });
+      if (stop_) {
+        return;
+      }
+    }
+  }
+
+  void Stop() noexcept {
+    {
+      std::lock_guard lock(sleep_mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+    workers_.Clear();
+  }
+
+  // Queue 0 is shared by threads outside the pool; worker i owns queue i.
+  static inline thread_local size_t current_queue_ = 0;
+
+  std::unique_ptr<Queue[]> queues_;
+  size_t queue_count_;
+  Vector<std::thread> workers_;
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::atomic<size_t> queued_{0};
+  bool stop_{false};
+};
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_THREAD_POOL_H_
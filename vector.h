@@ -1,13 +1,440 @@
 #ifndef OOP_ASSIGNMENTS_VECTOR_VECTOR_H_
 #define OOP_ASSIGNMENTS_VECTOR_VECTOR_H_
 #define VECTOR_MEMORY_IMPLEMENTED
+// Define VECTOR_STATS to collect allocation statistics, see vector_stats.h.
 #include <memory>
+#include <memory_resource>
 #include <iterator>
 #include <stdexcept>
 #include <exception>
 #include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
 
-template <typename T, class Allocator = std::allocator<T>>
+#include "vector_simd.h"
+#include "vector_stats.h"
+
+// Types whose objects can be moved to a new address by copying their bytes and forgetting
+// the source. Specialize for your own types to opt into bulk relocation.
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+template <typename T, typename Deleter>
+struct IsTriviallyRelocatable<std::unique_ptr<T, Deleter>> : IsTriviallyRelocatable<Deleter> {};
+
+template <typename T>
+inline constexpr bool kIsTriviallyRelocatableV = IsTriviallyRelocatable<T>::value;
+
+// Allocators whose construct/destroy have no side effects, so that elements may be relocated
+// without going through them. Specialize for custom allocators with trivial construct/destroy.
+template <class Allocator>
+struct AllowsTrivialRelocation : std::false_type {};
+
+template <typename T>
+struct AllowsTrivialRelocation<std::allocator<T>> : std::true_type {};
+
+// polymorphic_allocator only does more than placement new for allocator-aware types.
+template <typename T>
+struct AllowsTrivialRelocation<std::pmr::polymorphic_allocator<T>>
+    : std::bool_constant<!std::uses_allocator_v<T, std::pmr::polymorphic_allocator<T>>> {};
+
+template <class Allocator>
+inline constexpr bool kAllowsTrivialRelocationV = AllowsTrivialRelocation<Allocator>::value;
+
+// Selects the constructors that default-initialize elements instead of value-initializing them.
+struct DefaultInitTag {
+  explicit DefaultInitTag() = default;
+};
+
+inline constexpr DefaultInitTag kDefaultInit{};
+
+// Growth policies pick the capacity to allocate when `required` elements no longer fit into
+// `capacity` elements of `element_size` bytes. The result must not be less than `required`.
+struct DoublingGrowth {
+  static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+    return std::max(capacity * 2, required);
+  }
+};
+
+// Lets a freed block be reused by a later growth step of the same vector.
+struct OneAndHalfGrowth {
+  static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+    return std::max(capacity + capacity / 2, required);
+  }
+};
+
+// Rounds the base policy's request up to the allocator size class: a power of two below a
+// page and a whole number of pages above it, so the slack the allocator hands out is used.
+template <size_t PageSize = 4096, class BaseGrowth = DoublingGrowth>
+struct PageRoundedGrowth {
+  static_assert((PageSize & (PageSize - 1)) == 0, "PageSize must be a power of two");
+
+  static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+    size_t bytes = BaseGrowth::NextCapacity(capacity, required, element_size) * element_size;
+    if (bytes < PageSize) {
+      size_t size_class = 16;
+      while (size_class < bytes) {
+        size_class *= 2;
+      }
+      bytes = size_class;
+    } else {
+      bytes = (bytes + PageSize - 1) & ~(PageSize - 1);
+    }
+    return bytes / element_size;
+  }
+};
+
+// Grows geometrically until the buffer reaches MaxGeometricBytes, then linearly by that amount.
+template <size_t MaxGeometricBytes, class BaseGrowth = DoublingGrowth>
+struct CappedGeometricGrowth {
+  static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+    const size_t step = std::max<size_t>(MaxGeometricBytes / element_size, 1);
+    if (capacity >= step) {
+      return std::max(capacity + step, required);
+    }
+    return std::max(std::min(BaseGrowth::NextCapacity(capacity, required, element_size), step), required);
+  }
+};
+
+namespace vector_detail {
+
+// Exception-safe element construction shared by Vector and the containers built next to it.
+// Every function either completes or destroys what it built and rethrows.
+template <typename T, class Allocator>
+struct ElementOps {
+  using AllocTraits = std::allocator_traits<Allocator>;
+
+  static constexpr bool kBulkRelocation = kIsTriviallyRelocatableV<T> && kAllowsTrivialRelocationV<Allocator>;
+  // Same choice as std::move_if_noexcept: a throwing move would leave the source half-moved,
+  // so such types are copied during relocation unless they cannot be copied at all.
+  static constexpr bool kMoveOnRelocate = std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>;
+
+  static constexpr void Destroy(Allocator& alloc, T* buffer, size_t count) noexcept {
+    for (size_t i = 0; i < count; i++) {
+      AllocTraits::destroy(alloc, buffer + i);
+    }
+  }
+
+  template <typename CopyIterator>
+  static constexpr void CopyIterTo(Allocator& alloc, CopyIterator begin, CopyIterator end, T* buffer) {
+    size_t curr_size = 0;
+    try {
+      for (auto iter = begin; iter != end; ++iter) {
+        AllocTraits::construct(alloc, buffer + curr_size, *iter);
+        ++curr_size;
+      }
+    } catch (...) {
+      Destroy(alloc, buffer, curr_size);
+      throw;
+    }
+  }
+
+  static constexpr void ValueInitTo(Allocator& alloc, T* buffer, size_t count) {
+    size_t curr_size = 0;
+    try {
+      for (; curr_size < count; ++curr_size) {
+        AllocTraits::construct(alloc, buffer + curr_size);
+      }
+    } catch (...) {
+      Destroy(alloc, buffer, curr_size);
+      throw;
+    }
+  }
+
+  // Allocators that cannot have their construct bypassed get value-initialization instead, and
+  // so does constant evaluation, which has no indeterminate values.
+  static constexpr void DefaultInitTo(Allocator& alloc, T* buffer, size_t count) {
+    if (std::is_constant_evaluated()) {
+      ValueInitTo(alloc, buffer, count);
+    } else if constexpr (!kAllowsTrivialRelocationV<Allocator>) {
+      ValueInitTo(alloc, buffer, count);
+    } else if constexpr (!std::is_trivially_default_constructible_v<T>) {
+      size_t curr_size = 0;
+      try {
+        for (; curr_size < count; ++curr_size) {
+          ::new (static_cast<void*>(buffer + curr_size)) T;
+        }
+      } catch (...) {
+        Destroy(alloc, buffer, curr_size);
+        throw;
+      }
+    }
+  }
+
+  static constexpr void FillTo(Allocator& alloc, T* buffer, size_t count, const T& value) {
+    size_t curr_size = 0;
+    try {
+      for (; curr_size < count; ++curr_size) {
+        AllocTraits::construct(alloc, buffer + curr_size, value);
+      }
+    } catch (...) {
+      Destroy(alloc, buffer, curr_size);
+      throw;
+    }
+  }
+
+  template <typename MoveIterator>
+  static constexpr void MoveIterTo(Allocator& alloc, MoveIterator begin, MoveIterator end, T* buffer) {
+    using RelocationIterator = std::conditional_t<kMoveOnRelocate, std::move_iterator<MoveIterator>, MoveIterator>;
+    CopyIterTo(alloc, RelocationIterator(begin), RelocationIterator(end), buffer);
+  }
+
+  // Moves count elements from `from` into `to` and ends their lifetime at `from`. For trivially
+  // relocatable elements this is a single memcpy with no destroy pass.
+  static constexpr void RelocateTo(Allocator& alloc, T* from, size_t count, T* to) {
+    if constexpr (kBulkRelocation) {
+      if (std::is_constant_evaluated()) {
+        for (size_t i = 0; i < count; i++) {
+          RelocateOne(alloc, from + i, to + i);
+        }
+      } else if (count != 0) {
+        std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+      }
+    } else {
+      MoveIterTo(alloc, from, from + count, to);
+      Destroy(alloc, from, count);
+    }
+  }
+
+  // Same, leaving gap_size unconstructed slots in `to` before the element at gap_pos.
+  static constexpr void RelocateWithGap(Allocator& alloc, T* from, size_t count, T* to, size_t gap_pos,
+                                        size_t gap_size) {
+    if constexpr (kBulkRelocation) {
+      if (std::is_constant_evaluated()) {
+        for (size_t i = 0; i < count; i++) {
+          RelocateOne(alloc, from + i, to + (i < gap_pos ? i : i + gap_size));
+        }
+        return;
+      }
+      if (gap_pos != 0) {
+        std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), gap_pos * sizeof(T));
+      }
+      if (gap_pos != count) {
+        std::memcpy(static_cast<void*>(to + gap_pos + gap_size), static_cast<const void*>(from + gap_pos),
+                    (count - gap_pos) * sizeof(T));
+      }
+    } else {
+      MoveIterTo(alloc, from, from + gap_pos, to);
+      try {
+        MoveIterTo(alloc, from + gap_pos, from + count, to + gap_pos + gap_size);
+      } catch (...) {
+        Destroy(alloc, to, gap_pos);
+        throw;
+      }
+      Destroy(alloc, from, count);
+    }
+  }
+
+  // Shifts the bytes of buffer[idx, size) by `count` slots in either direction. Only for
+  // kBulkRelocation.
+  static constexpr void ShiftTail(Allocator& alloc, T* buffer, size_t size, size_t idx, ptrdiff_t count) noexcept {
+    if (std::is_constant_evaluated()) {
+      for (size_t i = 0; i < size - idx; i++) {
+        const size_t from = count > 0 ? size - 1 - i : idx + i;
+        RelocateOne(alloc, buffer + from, buffer + from + count);
+      }
+    } else if (idx != size) {
+      std::memmove(static_cast<void*>(buffer + idx + count), static_cast<const void*>(buffer + idx),
+                   (size - idx) * sizeof(T));
+    }
+  }
+
+  // What stands in for memcpy and memmove of trivially relocatable elements during constant
+  // evaluation, where copying bytes does not create objects.
+  static constexpr void RelocateOne(Allocator& alloc, T* from, T* to) {
+    AllocTraits::construct(alloc, to, std::move(*from));
+    AllocTraits::destroy(alloc, from);
+  }
+};
+
+template <class Allocator, class = void>
+struct HasAllocateAtLeast : std::false_type {};
+
+template <class Allocator>
+struct HasAllocateAtLeast<Allocator, std::void_t<decltype(std::declval<Allocator&>().allocate_at_least(size_t{}))>>
+    : std::true_type {};
+
+// Optional allocator extensions, both taking (pointer, old_count, new_count):
+//  - bool try_expand(...) resizes the block in place and returns whether it could;
+//  - pointer reallocate(...) resizes it like realloc, possibly moving the bytes, and returns
+//    nullptr leaving the block untouched on failure. Only used for bulk-relocatable elements.
+template <class Allocator, class = void>
+struct HasTryExpand : std::false_type {};
+
+template <class Allocator>
+struct HasTryExpand<Allocator, std::void_t<decltype(static_cast<bool>(std::declval<Allocator&>().try_expand(
+                                   std::declval<typename std::allocator_traits<Allocator>::pointer>(), size_t{},
+                                   size_t{})))>> : std::true_type {};
+
+template <class Allocator, class = void>
+struct HasReallocate : std::false_type {};
+
+template <class Allocator>
+struct HasReallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().reallocate(
+                                    std::declval<typename std::allocator_traits<Allocator>::pointer>(), size_t{},
+                                    size_t{}))>> : std::true_type {};
+
+template <class Allocator>
+struct AllocationResult {
+  typename std::allocator_traits<Allocator>::pointer ptr;
+  size_t count;
+};
+
+// Allocates room for at least count elements and reports how many the allocator actually
+// provided, through an allocate_at_least member or C++23 allocate_at_least when available.
+// Members are called directly: they may return their own result type, which the C++23 trait
+// could not convert to std::allocation_result.
+template <class Allocator>
+[[nodiscard]] constexpr AllocationResult<Allocator> AllocateAtLeast(Allocator& alloc, size_t count) {
+  if constexpr (HasAllocateAtLeast<Allocator>::value) {
+    auto result = alloc.allocate_at_least(count);
+    return {result.ptr, static_cast<size_t>(result.count)};
+  } else {
+#if defined(__cpp_lib_allocate_at_least)
+    auto result = std::allocator_traits<Allocator>::allocate_at_least(alloc, count);
+    return {result.ptr, static_cast<size_t>(result.count)};
+#else
+    return {std::allocator_traits<Allocator>::allocate(alloc, count), count};
+#endif
+  }
+}
+
+template <class GrowthPolicy, typename T, class Allocator>
+[[nodiscard]] constexpr size_t GrowCapacity(const Allocator& alloc, size_t capacity, size_t required) {
+  const size_t max_size = std::allocator_traits<Allocator>::max_size(alloc);
+  if (required > max_size) {
+    throw std::length_error("");
+  }
+  if (capacity > max_size / 2) {
+    return max_size;
+  }
+  return std::min(GrowthPolicy::NextCapacity(capacity, required, sizeof(T)), max_size);
+}
+
+// The position-based modifiers of Vector and SmallVector, written once for both. Container
+// befriends this struct and provides alloc_, buffer_, size_ and capacity_, plus
+// ReallocateWith(required, fill), which hands fill a buffer for at least `required` elements,
+// frees it if fill throws and otherwise replaces the old buffer with it. fill builds the new
+// elements and relocates the old ones into it.
+template <typename T, class Allocator>
+struct PositionOps {
+  using AllocTraits = std::allocator_traits<Allocator>;
+  using Ops = ElementOps<T, Allocator>;
+
+  static constexpr bool kBulkRelocation = Ops::kBulkRelocation;
+
+  // Constant evaluation cannot order unrelated pointers, only tell them apart.
+  [[nodiscard]] static constexpr bool IsElement(const T* buffer, size_t size, const T& value) noexcept {
+    if (std::is_constant_evaluated()) {
+      return std::find_if(buffer, buffer + size, [&](const T& element) { return &element == &value; }) !=
+             buffer + size;
+    }
+    return std::less_equal<const T*>()(buffer, std::addressof(value)) &&
+           std::less<const T*>()(std::addressof(value), buffer + size);
+  }
+
+  template <class Container, class... Args>
+  static constexpr void EmplaceAt(Container& c, size_t idx, Args&&... args) {
+    if constexpr (kBulkRelocation) {
+      if (c.size_ < c.capacity_ && std::is_constant_evaluated()) {
+        T value(std::forward<Args>(args)...);
+        InsertWith(c, idx, 1, [&](T* gap) { AllocTraits::construct(c.alloc_, gap, std::move(value)); });
+        return;
+      }
+      if (c.size_ < c.capacity_) {
+        // Built aside first, so that args may refer to elements that are about to shift.
+        alignas(T) unsigned char storage[sizeof(T)];
+        auto value = reinterpret_cast<T*>(storage);
+        AllocTraits::construct(c.alloc_, value, std::forward<Args>(args)...);
+        Ops::ShiftTail(c.alloc_, c.buffer_, c.size_, idx, 1);
+        std::memcpy(static_cast<void*>(c.buffer_ + idx), static_cast<const void*>(value), sizeof(T));
+        ++c.size_;
+        return;
+      }
+    }
+    InsertWith(c, idx, 1, [&](T* gap) { AllocTraits::construct(c.alloc_, gap, std::forward<Args>(args)...); });
+  }
+
+  template <class Container>
+  static constexpr void InsertFill(Container& c, size_t idx, size_t count, const T& value) {
+    if (kBulkRelocation && IsElement(c.buffer_, c.size_, value)) {
+      T copy(value);
+      InsertFill(c, idx, count, copy);
+      return;
+    }
+    InsertWith(c, idx, count, [&](T* gap) { Ops::FillTo(c.alloc_, gap, count, value); });
+  }
+
+  template <class Container, typename ForwardIterator>
+  static constexpr void InsertRange(Container& c, size_t idx, ForwardIterator first, ForwardIterator last) {
+    InsertWith(c, idx, static_cast<size_t>(std::distance(first, last)),
+               [&](T* gap) { Ops::CopyIterTo(c.alloc_, first, last, gap); });
+  }
+
+  // Inserts `count` elements before idx, built by build(gap) on uninitialized slots; build must
+  // clean up after itself when it throws. The strong guarantee holds when the container
+  // reallocates or its elements are trivially relocatable, otherwise the basic one: the new
+  // elements are built at the end and rotated into place.
+  template <class Container, typename Builder>
+  static constexpr void InsertWith(Container& c, size_t idx, size_t count, Builder&& build) {
+    if (count == 0) {
+      return;
+    }
+    if (count > c.capacity_ - c.size_) {
+      if (count > AllocTraits::max_size(c.alloc_) - c.size_) {
+        throw std::length_error("");
+      }
+      c.ReallocateWith(c.size_ + count, [&](T* new_buff) {
+        build(new_buff + idx);
+        try {
+          Ops::RelocateWithGap(c.alloc_, c.buffer_, c.size_, new_buff, idx, count);
+        } catch (...) {
+          Ops::Destroy(c.alloc_, new_buff + idx, count);
+          throw;
+        }
+      });
+    } else if constexpr (kBulkRelocation) {
+      Ops::ShiftTail(c.alloc_, c.buffer_, c.size_, idx, static_cast<ptrdiff_t>(count));
+      try {
+        build(c.buffer_ + idx);
+      } catch (...) {
+        Ops::ShiftTail(c.alloc_, c.buffer_, c.size_ + count, idx + count, -static_cast<ptrdiff_t>(count));
+        throw;
+      }
+    } else {
+      build(c.buffer_ + c.size_);
+      c.size_ += count;
+      std::rotate(c.buffer_ + idx, c.buffer_ + c.size_ - count, c.buffer_ + c.size_);
+      return;
+    }
+    c.size_ += count;
+  }
+
+  // Basic guarantee if a move assignment throws; trivially relocatable elements are shifted
+  // with one memmove.
+  template <class Container>
+  static constexpr void EraseRange(Container& c, size_t idx, size_t count) {
+    if (count == 0) {
+      return;
+    }
+    if constexpr (kBulkRelocation) {
+      Ops::Destroy(c.alloc_, c.buffer_ + idx, count);
+      Ops::ShiftTail(c.alloc_, c.buffer_, c.size_, idx + count, -static_cast<ptrdiff_t>(count));
+    } else {
+      std::move(c.buffer_ + idx + count, c.buffer_ + c.size_, c.buffer_ + idx);
+      Ops::Destroy(c.alloc_, c.buffer_ + c.size_ - count, count);
+    }
+    c.size_ -= count;
+  }
+};
+
+}  // namespace vector_detail
+
+template <typename T, class Allocator = std::allocator<T>, class GrowthPolicy = DoublingGrowth>
 class Vector {
  public:
   using ValueType = T;
@@ -25,19 +452,25 @@ class Vector {
   template <class Iter>
   using EnableIfForwardIter = std::enable_if_t<
       std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>>;
+  template <class Iter>
+  using EnableIfSinglePassIter = std::enable_if_t<
+      std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<Iter>::iterator_category> &&
+      !std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>>;
 
  public:
-  Vector() noexcept = default;
-  Vector(const std::initializer_list<T>& init_lst) {
+  constexpr Vector() noexcept = default;
+  explicit constexpr Vector(const Allocator& alloc) noexcept : alloc_(alloc) {
+  }
+  constexpr Vector(const std::initializer_list<T>& init_lst, const Allocator& alloc = Allocator()) : alloc_(alloc) {
     try {
       size_ = init_lst.size();
       capacity_ = size_;
       if (init_lst.size() != 0) {
-        buffer_ = AllocTraits::allocate(alloc_, capacity_);
+        buffer_ = AllocateBuffer(capacity_);
         CopyIterRange(init_lst.begin(), init_lst.end());
       }
     } catch (...) {
-      AllocTraits::deallocate(alloc_, buffer_, capacity_);
+      DeallocateBuffer();
       size_ = 0;
       capacity_ = 0;
       buffer_ = nullptr;
@@ -45,16 +478,16 @@ class Vector {
     }
   }  // copy safety
 
-  Vector(std::initializer_list<T>&& init_lst) {
+  constexpr Vector(std::initializer_list<T>&& init_lst, const Allocator& alloc = Allocator()) : alloc_(alloc) {
     try {
       size_ = init_lst.size();
       capacity_ = size_;
       if (init_lst.size() != 0) {
-        buffer_ = AllocTraits::allocate(alloc_, capacity_);
+        buffer_ = AllocateBuffer(capacity_);
         MoveIterRange(init_lst.begin(), init_lst.end());
       }
     } catch (...) {
-      AllocTraits::deallocate(alloc_, buffer_, capacity_);
+      DeallocateBuffer();
       size_ = 0;
       capacity_ = 0;
       buffer_ = nullptr;
@@ -63,16 +496,16 @@ class Vector {
   }  // copy safety
 
   template <typename InputIterator, typename = EnableIfForwardIter<InputIterator>>
-  Vector(InputIterator begin, InputIterator end) {
+  constexpr Vector(InputIterator begin, InputIterator end, const Allocator& alloc = Allocator()) : alloc_(alloc) {
     try {
       size_ = std::distance(begin, end);
-      capacity_ = size_ * 2;
+      capacity_ = size_;
       if (size_ != 0) {
-        buffer_ = AllocTraits::allocate(alloc_, capacity_);
+        buffer_ = AllocateBuffer(capacity_);
         CopyIterRange(begin, end);
       }
     } catch (...) {
-      AllocTraits::deallocate(alloc_, buffer_, capacity_);
+      DeallocateBuffer();
       size_ = 0;
       capacity_ = 0;
       buffer_ = nullptr;
@@ -80,17 +513,33 @@ class Vector {
     }
   }  // copy safety
 
-  Vector(const Vector& other) {
+  // Single-pass ranges are read once, growing as they go.
+  template <typename InputIterator, EnableIfSinglePassIter<InputIterator>* = nullptr>
+  constexpr Vector(InputIterator begin, InputIterator end, const Allocator& alloc = Allocator()) : alloc_(alloc) {
+    try {
+      AppendFrom(begin, end);
+    } catch (...) {
+      DeallocateBuffer();
+      capacity_ = 0;
+      buffer_ = nullptr;
+      throw;
+    }
+  }
+
+  constexpr Vector(const Vector& other)
+      : Vector(other, AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+  }
+
+  constexpr Vector(const Vector& other, const Allocator& alloc) : alloc_(alloc) {
     try {
-      alloc_ = other.alloc_;
       size_ = other.size_;
-      capacity_ = other.capacity_;
+      capacity_ = other.size_;
       if (size_ != 0) {
-        buffer_ = AllocTraits::allocate(alloc_, capacity_);
+        buffer_ = AllocateBuffer(capacity_);
         CopyIterRange(other.begin(), other.end());
       }
     } catch (...) {
-      AllocTraits::deallocate(alloc_, buffer_, capacity_);
+      DeallocateBuffer();
       size_ = 0;
       capacity_ = 0;
       buffer_ = nullptr;
@@ -98,20 +547,51 @@ class Vector {
     }
   }
 
-  Vector(Vector&& other) noexcept
+  constexpr Vector(Vector&& other) noexcept
       : alloc_(other.alloc_)
       , buffer_(std::exchange(other.buffer_, nullptr))
       , size_(std::exchange(other.size_, 0))
       , capacity_(std::exchange(other.capacity_, 0)) {
   }
 
-  explicit Vector(size_t size) {
+  // Moves element by element when alloc cannot free other's buffer.
+  constexpr Vector(Vector&& other, const Allocator& alloc) : alloc_(alloc) {
+    if (alloc_ == other.alloc_) {
+      buffer_ = std::exchange(other.buffer_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      capacity_ = std::exchange(other.capacity_, 0);
+    } else {
+      AppendWith(other.size_, [&](Pointer gap) {
+        CopyIterTo(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()), gap);
+      });
+      other.Clear();
+    }
+  }
+
+  constexpr Vector(size_t size, DefaultInitTag, const Allocator& alloc = Allocator()) : alloc_(alloc) {
+    try {
+      size_ = size;
+      capacity_ = size;
+      if (size != 0) {
+        buffer_ = AllocateBuffer(capacity_);
+        ElementOps::DefaultInitTo(alloc_, buffer_, size);
+      }
+    } catch (...) {
+      DeallocateBuffer();
+      size_ = 0;
+      capacity_ = 0;
+      buffer_ = nullptr;
+      throw;
+    }
+  }
+
+  explicit constexpr Vector(size_t size, const Allocator& alloc = Allocator()) : alloc_(alloc) {
     size_t count = 0;
     try {
       size_ = size;
       capacity_ = size;
       if (size != 0) {
-        buffer_ = AllocTraits::allocate(alloc_, capacity_);
+        buffer_ = AllocateBuffer(capacity_);
         for (auto iter = begin(); iter != end(); ++iter) {
           AllocTraits::construct(alloc_, iter);
           ++count;
@@ -121,7 +601,7 @@ class Vector {
       for (size_t i = 0; i < count; i++) {
         AllocTraits::destroy(alloc_, buffer_ + i);
       }
-      AllocTraits::deallocate(alloc_, buffer_, capacity_);
+      DeallocateBuffer();
       size_ = 0;
       capacity_ = 0;
       buffer_ = nullptr;
@@ -129,13 +609,13 @@ class Vector {
     }
   }
 
-  Vector(size_t size, const T& value) {
+  constexpr Vector(size_t size, const T& value, const Allocator& alloc = Allocator()) : alloc_(alloc) {
     size_t count = 0;
     try {
       size_ = size;
       capacity_ = size;
       if (size != 0) {
-        buffer_ = AllocTraits::allocate(alloc_, capacity_);
+        buffer_ = AllocateBuffer(capacity_);
         for (auto iter = begin(); iter != end(); ++iter) {
           AllocTraits::construct(alloc_, iter, value);
           ++count;
@@ -145,7 +625,7 @@ class Vector {
       for (size_t i = 0; i < count; i++) {
         AllocTraits::destroy(alloc_, buffer_ + i);
       }
-      AllocTraits::deallocate(alloc_, buffer_, capacity_);
+      DeallocateBuffer();
       size_ = 0;
       capacity_ = 0;
       buffer_ = nullptr;
@@ -153,400 +633,775 @@ class Vector {
     }
   }
 
-  Vector& operator=(const Vector& other) {
+  constexpr Vector& operator=(const Vector& other) {
     if (this != &other) {
-      auto backup_buff = std::exchange(buffer_, nullptr);
-      auto backup_size = std::exchange(size_, 0);
-      auto backup_capacity = std::exchange(capacity_, 0);
-      try {
-        Vector(other).Swap(*this);
-        for (size_t i = 0; i < backup_size; i++) {
-          AllocTraits::destroy(alloc_, backup_buff + i);
-        }
-        AllocTraits::deallocate(alloc_, backup_buff, backup_capacity);
-      } catch (...) {
-        buffer_ = backup_buff;
-        size_ = backup_size;
-        capacity_ = backup_capacity;
-        throw;
-      }
+      Vector copy(other, kPropagateOnCopy ? other.alloc_ : alloc_);
+      SwapStorage(copy);
+      std::swap(alloc_, copy.alloc_);
     }
     return *this;
   }
-  Vector& operator=(Vector&& other) noexcept {
+  // With unequal allocators that do not propagate, the elements are moved one by one into
+  // this vector's buffer.
+  constexpr Vector& operator=(Vector&& other) noexcept(kPropagateOnMove || AllocTraits::is_always_equal::value) {
     if (this != &other) {
-      Vector(std::move(other)).Swap(*this);
+      if constexpr (kPropagateOnMove || AllocTraits::is_always_equal::value) {
+        StealFrom(other);
+      } else if (alloc_ == other.alloc_) {
+        StealFrom(other);
+      } else {
+        Assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        other.Clear();
+      }
     }
     return *this;
   }
 
-  ~Vector() noexcept(std::is_nothrow_destructible_v<ValueType>) {
+  constexpr ~Vector() noexcept(std::is_nothrow_destructible_v<ValueType>) {
     for (size_t i = 0; i < size_; i++) {
       AllocTraits::destroy(alloc_, buffer_ + i);
     }
-    AllocTraits::deallocate(alloc_, buffer_, capacity_);
+    stats_.OnDestroy((capacity_ - size_) * sizeof(T));
+    DeallocateBuffer();
   }
 
-  [[nodiscard]] SizeType Size() const noexcept {
+  [[nodiscard]] constexpr SizeType Size() const noexcept {
     return size_;
   }
-  [[nodiscard]] SizeType Capacity() const noexcept {
+  [[nodiscard]] constexpr SizeType Capacity() const noexcept {
     return capacity_;
   }
-  [[nodiscard]] bool Empty() const noexcept {
+  [[nodiscard]] constexpr bool Empty() const noexcept {
     return size_ == 0;
   }
-  [[nodiscard]] ConstReference Front() const noexcept {
+  [[nodiscard]] constexpr ConstReference Front() const noexcept {
     return buffer_[0];
   }
-  [[nodiscard]] Reference Front() noexcept {
+  [[nodiscard]] constexpr Reference Front() noexcept {
     return const_cast<Reference>(const_cast<const Vector&>(*this).Front());
   }
-  [[nodiscard]] ConstReference Back() const noexcept {
+  [[nodiscard]] constexpr ConstReference Back() const noexcept {
     return buffer_[size_ - 1];
   }
-  [[nodiscard]] Reference Back() noexcept {
+  [[nodiscard]] constexpr Reference Back() noexcept {
     return const_cast<Reference>(const_cast<const Vector&>(*this).Back());
   }
-  [[nodiscard]] ConstReference At(size_t idx) const {
+  [[nodiscard]] constexpr ConstReference At(size_t idx) const {
     if (idx >= size_) {
       throw std::out_of_range("");
     }
     return (*this)[idx];
   }
-  [[nodiscard]] Reference At(size_t idx) {
+  [[nodiscard]] constexpr Reference At(size_t idx) {
     return const_cast<T&>(const_cast<const Vector&>(*this).At(idx));
   }
-  [[nodiscard]] ConstPointer Data() const noexcept {
+  [[nodiscard]] constexpr ConstPointer Data() const noexcept {
     return buffer_;
   }
-  [[nodiscard]] Pointer Data() noexcept {
+  [[nodiscard]] constexpr Pointer Data() noexcept {
     return const_cast<Pointer>(const_cast<const Vector&>(*this).Data());
   }
-  [[nodiscard]] ConstReference operator[](size_t idx) const noexcept {
+  [[nodiscard]] constexpr ConstReference operator[](size_t idx) const noexcept {
     return buffer_[idx];
   }
-  [[nodiscard]] Reference operator[](size_t idx) noexcept {
+  [[nodiscard]] constexpr Reference operator[](size_t idx) noexcept {
     return const_cast<T&>(const_cast<const Vector&>(*this)[idx]);
   }
 
-  void Swap(Vector& other) noexcept {
-    std::swap(buffer_, other.buffer_);
-    std::swap(size_, other.size_);
-    std::swap(capacity_, other.capacity_);
-    std::swap(alloc_, other.alloc_);
+  // Searches run vectorized for arithmetic T, and through the std algorithms otherwise.
+  [[nodiscard]] constexpr ConstIterator Find(const T& value) const {
+    if constexpr (vector_simd::kVectorizable<T>) {
+      if (!std::is_constant_evaluated()) {
+        return begin() + vector_simd::Find(Data(), size_, value);
+      }
+    }
+    return std::find(begin(), end(), value);
+  }
+  [[nodiscard]] constexpr Iterator Find(const T& value) {
+    return begin() + (const_cast<const Vector&>(*this).Find(value) - cbegin());
+  }
+  [[nodiscard]] constexpr size_t Count(const T& value) const {
+    if constexpr (vector_simd::kVectorizable<T>) {
+      if (!std::is_constant_evaluated()) {
+        return vector_simd::Count(Data(), size_, value);
+      }
+    }
+    return static_cast<size_t>(std::count(begin(), end(), value));
+  }
+  [[nodiscard]] constexpr bool Contains(const T& value) const {
+    return Find(value) != end();
+  }
+  // The first smallest and the last largest element, like std::minmax_element; {end, end} if empty.
+  [[nodiscard]] constexpr std::pair<ConstIterator, ConstIterator> MinMax() const {
+    if constexpr (vector_simd::kVectorizable<T>) {
+      if (size_ != 0 && !std::is_constant_evaluated()) {
+        const auto [min, max] = vector_simd::MinMax(Data(), size_);
+        const size_t min_idx = vector_simd::Find(Data(), size_, min);
+        const size_t max_idx = vector_simd::FindLast(Data(), size_, max);
+        // Only NaNs can make the extremes unfindable.
+        if (min_idx != size_ && max_idx != size_) {
+          return {begin() + min_idx, begin() + max_idx};
+        }
+      }
+    }
+    return std::minmax_element(begin(), end());
   }
-  void Clear() noexcept(std::is_nothrow_destructible_v<ValueType>) {
+
+  [[nodiscard]] constexpr Allocator GetAllocator() const noexcept {
+    return alloc_;
+  }
+
+  // Reports to the stats entry of tag from now on; a no-op without VECTOR_STATS.
+  constexpr void SetStatsTag(const char* tag) noexcept {
+    stats_.SetTag(tag);
+  }
+
+  // Allocators are only exchanged when they propagate on swap; otherwise they must compare equal.
+  constexpr void Swap(Vector& other) noexcept {
+    SwapStorage(other);
+    if constexpr (AllocTraits::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
+  }
+
+  struct ReleasedBuffer {
+    Pointer data;
+    SizeType size;
+    SizeType capacity;
+  };
+  // Hands the buffer over without touching the elements and leaves the vector empty. The
+  // caller must destroy the elements and deallocate data with an allocator equal to
+  // GetAllocator(), passing capacity, or give it to Adopt.
+  [[nodiscard]] constexpr ReleasedBuffer Release() noexcept {
+    const ReleasedBuffer released{buffer_, size_, capacity_};
+    buffer_ = nullptr;
+    size_ = 0;
+    capacity_ = 0;
+    return released;
+  }
+  // Replaces the contents with a buffer of capacity elements, the first size of them
+  // constructed, allocated by an allocator equal to GetAllocator(); data may be null if
+  // capacity is 0.
+  constexpr void Adopt(Pointer data, SizeType size, SizeType capacity) noexcept(
+      std::is_nothrow_destructible_v<ValueType>) {
+    assert(size <= capacity && (data != nullptr || capacity == 0));
+    Clear();
+    DeallocateBuffer();
+    buffer_ = data;
+    size_ = size;
+    capacity_ = capacity;
+  }
+
+  constexpr void Clear() noexcept(std::is_nothrow_destructible_v<ValueType>) {
     for (size_t i = 0; i < size_; i++) {
       AllocTraits::destroy(alloc_, buffer_ + i);
     }
     size_ = 0;
   }
-  void Resize(size_t size) {
-    if (size == size_) {
-      return;
+  constexpr void Resize(size_t size) {
+    ResizeWith(size, [&](Pointer gap, size_t count) { ElementOps::ValueInitTo(alloc_, gap, count); });
+  }
+  constexpr void Resize(size_t size, const T& value) {
+    ResizeWith(size, [&](Pointer gap, size_t count) { ElementOps::FillTo(alloc_, gap, count, value); });
+  }
+  // Like Resize, but new elements are default-initialized: trivial types are left
+  // uninitialized instead of being zeroed.
+  constexpr void ResizeDefaultInit(size_t size) {
+    ResizeWith(size, [&](Pointer gap, size_t count) { ElementOps::DefaultInitTo(alloc_, gap, count); });
+  }
+  // Grows the buffer to hold `size` elements and calls op(Data(), size), which returns the new
+  // Size(), at most `size`. For trivially copyable T, op may write any of those slots. For
+  // other types, op must construct exactly the slots in [Size(), result) and destroy what it
+  // built if it throws; Size() is unchanged in that case. A result below Size() destroys the
+  // elements past it. A result above `size` throws std::length_error, after destroying what op
+  // claims to have built within the buffer.
+  template <typename Operation>
+  constexpr void ResizeForOverwrite(size_t size, Operation op) {
+    if (size > capacity_) {
+      Reserve(GrowCapacity(size));
     }
-    if (size < size_) {
-      for (size_t i = size; i < size_; i++) {
-        AllocTraits::destroy(alloc_, buffer_ + i);
+    const size_t new_size = std::move(op)(buffer_, size);
+    if (new_size > size) {
+      if (size > size_) {
+        ElementOps::Destroy(alloc_, buffer_ + size_, size - size_);
       }
-      size_ = size;
+      throw std::length_error("");
+    }
+    if (new_size < size_) {
+      ElementOps::Destroy(alloc_, buffer_ + new_size, size_ - new_size);
+    }
+    size_ = new_size;
+  }
+
+  struct WriteWindow {
+    Pointer data;
+    SizeType size;
+  };
+  // Streaming counterpart of ResizeForOverwrite for trivially copyable T: grows through the
+  // growth policy until at least min_count elements fit after Size(), and returns all the spare
+  // capacity, e.g. for read() or recv() to fill in place. Commit(count) then appends the first
+  // count elements written there. Anything that may reallocate invalidates the window.
+  [[nodiscard]] constexpr WriteWindow AcquireWriteWindow(size_t min_count) requires std::is_trivially_copyable_v<T> {
+    ReserveMore(min_count);
+    return {buffer_ + size_, capacity_ - size_};
+  }
+  constexpr void Commit(size_t count) requires std::is_trivially_copyable_v<T> {
+    if (count > capacity_ - size_) {
+      throw std::length_error("");
+    }
+    size_ += count;
+  }
+
+  constexpr void Reserve(size_t capacity) {
+    if (capacity_ >= capacity) {
       return;
     }
-    size_t count = 0;
-    if (size <= capacity_) {
-      auto backup_size = size_;
+    [[maybe_unused]] const auto growth = stats_.TimeGrowth();
+    if (!TryResizeBuffer(capacity, true)) {
+      auto [new_buff, new_capacity] = AllocateAtLeast(capacity);
       try {
-        for (size_t i = size_; i < size; ++i) {
-          AllocTraits::construct(alloc_, buffer_ + i);
-          ++count;
-        }
-        size_ = size;
+        RelocateTo(new_buff);
       } catch (...) {
-        size_ = backup_size;
-        for (size_t i = size_; i < size_ + count; i++) {
-          AllocTraits::destroy(alloc_, buffer_ + i);
-        }
+        AllocTraits::deallocate(alloc_, new_buff, new_capacity);
         throw;
       }
+      ReplaceBuffer(new_buff, new_capacity);
+    }
+  }
+  constexpr void ShrinkToFit() {
+    if (size_ == capacity_) {
       return;
     }
-    if (size > capacity_) {
-      auto backup_buff = buffer_;
-      auto backup_size = size_;
-      auto backup_capacity = capacity_;
-      auto new_buff = AllocTraits::allocate(alloc_, size * 2);
+    if (size_ == 0) {
+      DeallocateBuffer();
+      buffer_ = nullptr;
+    } else if (kBulkRelocation && vector_detail::HasReallocate<Allocator>::value && TryResizeBuffer(size_, true)) {
+      return;
+    } else {
+      auto new_buff = AllocateBuffer(size_);
       try {
-        for (size_t i = size_; i < size; ++i) {
-          AllocTraits::construct(alloc_, new_buff + i);
-          ++count;
-        }
-        MoveIterTo(begin(), end(), new_buff);
-        for (size_t i = 0; i < size_; i++) {
-          AllocTraits::destroy(alloc_, buffer_ + i);
-        }
-        AllocTraits::deallocate(alloc_, buffer_, capacity_);
-        capacity_ = size * 2;
-        buffer_ = new_buff;
-        size_ = size;
+        RelocateTo(new_buff);
       } catch (...) {
-        for (size_t i = size_; i < size_ + count; i++) {
-          AllocTraits::destroy(alloc_, new_buff + i);
-        }
-        AllocTraits::deallocate(alloc_, new_buff, capacity_);
-        capacity_ = backup_capacity;
-        size_ = backup_size;
-        buffer_ = backup_buff;
+        AllocTraits::deallocate(alloc_, new_buff, size_);
         throw;
       }
+      ReplaceBuffer(new_buff, size_);
     }
+    capacity_ = size_;
   }
-  void Resize(size_t size, const T& value) {
-    if (size == size_) {
+
+  template <class... Args>
+  constexpr void EmplaceBack(Args&&... args) {
+    if (size_ < capacity_) [[likely]] {
+      AllocTraits::construct(alloc_, buffer_ + size_, std::forward<Args>(args)...);
+      ++size_;
+    } else if constexpr (std::is_trivially_copyable_v<T>) {
+      // Growing is an allocation and a memcpy here. Inline, it lets a local vector's fields
+      // stay in registers across the loop.
+      GrowAndEmplaceBack(std::forward<Args>(args)...);
+    } else {
+      ColdGrowAndEmplaceBack(std::forward<Args>(args)...);
+    }
+  }
+
+  // EmplaceBack for callers that have already made room, e.g. with Reserve: no capacity check
+  // outside of debug builds.
+  template <class... Args>
+  constexpr void UncheckedEmplaceBack(Args&&... args) {
+    assert(size_ < capacity_);
+    AllocTraits::construct(alloc_, buffer_ + size_, std::forward<Args>(args)...);
+    ++size_;
+  }
+
+  constexpr void PushBack(const T& value) {
+    EmplaceBack(value);
+  }
+  constexpr void PushBack(T&& value) {
+    EmplaceBack(std::move(value));
+  }
+  constexpr void UncheckedPushBack(const T& value) {
+    UncheckedEmplaceBack(value);
+  }
+  constexpr void UncheckedPushBack(T&& value) {
+    UncheckedEmplaceBack(std::move(value));
+  }
+  constexpr void PopBack() noexcept(std::is_nothrow_destructible_v<ValueType>) {
+    if (!Empty()) {
+      --size_;
+      AllocTraits::destroy(alloc_, buffer_ + size_);
+    }
+  }
+
+  template <class... Args>
+  constexpr Iterator EmplaceAt(ConstIterator pos, Args&&... args) {
+    const auto idx = static_cast<size_t>(pos - cbegin());
+    PositionOps::EmplaceAt(*this, idx, std::forward<Args>(args)...);
+    return begin() + idx;
+  }
+  constexpr Iterator Insert(ConstIterator pos, const T& value) {
+    return EmplaceAt(pos, value);
+  }
+  constexpr Iterator Insert(ConstIterator pos, T&& value) {
+    return EmplaceAt(pos, std::move(value));
+  }
+  constexpr Iterator Insert(ConstIterator pos, size_t count, const T& value) {
+    const auto idx = static_cast<size_t>(pos - cbegin());
+    PositionOps::InsertFill(*this, idx, count, value);
+    return begin() + idx;
+  }
+  template <typename InputIterator, typename = EnableIfForwardIter<InputIterator>>
+  constexpr Iterator Insert(ConstIterator pos, InputIterator first, InputIterator last) {
+    const auto idx = static_cast<size_t>(pos - cbegin());
+    PositionOps::InsertRange(*this, idx, first, last);
+    return begin() + idx;
+  }
+  constexpr Iterator Insert(ConstIterator pos, std::initializer_list<T> init_lst) {
+    return Insert(pos, init_lst.begin(), init_lst.end());
+  }
+
+  constexpr Iterator Erase(ConstIterator pos) {
+    return Erase(pos, pos + 1);
+  }
+  // Basic guarantee if a move assignment throws; trivially relocatable elements are shifted
+  // with one memmove.
+  constexpr Iterator Erase(ConstIterator first, ConstIterator last) {
+    const auto idx = static_cast<size_t>(first - cbegin());
+    PositionOps::EraseRange(*this, idx, static_cast<size_t>(last - first));
+    return begin() + idx;
+  }
+
+  // Assign reuses the buffer when it is large enough; in that case only the basic guarantee is
+  // kept if an element assignment or copy throws. Otherwise it allocates once, exactly.
+  template <typename InputIterator, typename = EnableIfForwardIter<InputIterator>>
+  constexpr void Assign(InputIterator first, InputIterator last) {
+    const auto count = static_cast<size_t>(std::distance(first, last));
+    if (count > capacity_) {
+      AssignToNewBuffer(count, [&](Pointer new_buff) { CopyIterTo(first, last, new_buff); });
       return;
     }
-    if (size < size_) {
-      for (size_t i = size; i < size_; i++) {
+    auto mid = first;
+    std::advance(mid, std::min(count, size_));
+    std::copy(first, mid, buffer_);
+    if (count > size_) {
+      CopyIterTo(mid, last, buffer_ + size_);
+    } else {
+      for (size_t i = count; i < size_; i++) {
         AllocTraits::destroy(alloc_, buffer_ + i);
       }
-      size_ = size;
-      return;
     }
-    size_t count = 0;
-    if (size <= capacity_) {
-      auto backup_size = size_;
-      try {
-        for (size_t i = size_; i < size; ++i) {
-          AllocTraits::construct(alloc_, buffer_ + i, value);
-          ++count;
-        }
-        size_ = size;
-      } catch (...) {
-        for (size_t i = size_; i < size_ + count; i++) {
-          AllocTraits::destroy(alloc_, buffer_ + i);
-        }
-        size_ = backup_size;
-        throw;
-      }
+    size_ = count;
+  }
+  constexpr void Assign(size_t count, const T& value) {
+    if (count > capacity_) {
+      AssignToNewBuffer(count, [&](Pointer new_buff) { FillTo(new_buff, count, value); });
       return;
     }
-    if (size > capacity_) {
-      auto backup_buff = buffer_;
-      auto backup_size = size_;
-      auto backup_capacity = capacity_;
-      auto new_buff = AllocTraits::allocate(alloc_, size * 2);
-      try {
-        for (size_t i = size_; i < size; ++i) {
-          AllocTraits::construct(alloc_, new_buff + i, value);
-          ++count;
-        }
-        MoveIterTo(begin(), end(), new_buff);
-        for (size_t i = 0; i < size_; i++) {
-          AllocTraits::destroy(alloc_, buffer_ + i);
-        }
-        AllocTraits::deallocate(alloc_, buffer_, capacity_);
-        capacity_ = size * 2;
-        buffer_ = new_buff;
-        size_ = size;
-      } catch (...) {
-        for (size_t i = size_; i < size_ + count; i++) {
-          AllocTraits::destroy(alloc_, new_buff + i);
-        }
-        AllocTraits::deallocate(alloc_, new_buff, capacity_);
-        capacity_ = backup_capacity;
-        size_ = backup_size;
-        buffer_ = backup_buff;
-        throw;
+    std::fill(buffer_, buffer_ + std::min(count, size_), value);
+    if (count > size_) {
+      FillTo(buffer_ + size_, count - size_, value);
+    } else {
+      for (size_t i = count; i < size_; i++) {
+        AllocTraits::destroy(alloc_, buffer_ + i);
       }
     }
+    size_ = count;
+  }
+  constexpr void Assign(std::initializer_list<T> init_lst) {
+    Assign(init_lst.begin(), init_lst.end());
+  }
+
+  // Appends [first, last) with at most one reallocation; strong guarantee.
+  template <typename InputIterator, typename = EnableIfForwardIter<InputIterator>>
+  constexpr void AppendRange(InputIterator first, InputIterator last) {
+    AppendWith(static_cast<size_t>(std::distance(first, last)),
+               [&](Pointer gap) { CopyIterTo(first, last, gap); });
   }
-  void Reserve(size_t capacity) {
-    if (capacity_ < capacity) {
-      auto backup_buff = buffer_;
-      auto backup_capacity = capacity_;
+
+  // Appends any input range, reserving room for size_hint elements up front; forward ranges
+  // are measured instead. If reading or building an element throws, the elements appended so
+  // far are destroyed again.
+  template <typename InputIterator>
+  constexpr void AppendFrom(InputIterator first, InputIterator last, size_t size_hint = 0) {
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                    typename std::iterator_traits<InputIterator>::iterator_category>) {
+      static_cast<void>(size_hint);
+      AppendRange(first, last);
+    } else {
+      ReserveMore(size_hint);
+      const size_t old_size = size_;
       try {
-        auto new_buff = AllocTraits::allocate(alloc_, capacity);
-        MoveIterTo(begin(), end(), new_buff);
-        for (size_t i = 0; i < size_; i++) {
-          AllocTraits::destroy(alloc_, buffer_ + i);
+        for (; first != last; ++first) {
+          EmplaceBack(*first);
         }
-        AllocTraits::deallocate(alloc_, buffer_, capacity_);
-        capacity_ = capacity;
-        buffer_ = new_buff;
       } catch (...) {
-        capacity_ = backup_capacity;
-        buffer_ = backup_buff;
-        throw;
-      }
-    }
-  }
-  void ShrinkToFit() {
-    auto backup_buff = buffer_;
-    auto backup_size = size_;
-    auto backup_capacity = capacity_;
-    try {
-      if (size_ == 0) {
-        AllocTraits::deallocate(alloc_, buffer_, capacity_);
-        buffer_ = nullptr;
-      } else {
-        auto new_buff = AllocTraits::allocate(alloc_, size_);
-        MoveIterTo(begin(), end(), new_buff);
-        for (size_t i = 0; i < size_; i++) {
+        for (size_t i = old_size; i < size_; i++) {
           AllocTraits::destroy(alloc_, buffer_ + i);
         }
-        AllocTraits::deallocate(alloc_, buffer_, capacity_);
-        buffer_ = new_buff;
+        size_ = old_size;
+        throw;
       }
-      capacity_ = size_;
-    } catch (...) {
-      capacity_ = backup_capacity;
-      size_ = backup_size;
-      buffer_ = backup_buff;
-      throw;
     }
   }
 
-  template <class... Args>
-  void EmplaceBack(Args&&... args) {
-    if (size_ < capacity_) {
+  // Appends n elements built from generate(), called in order, with at most one reallocation
+  // and no capacity check per element; strong guarantee.
+  template <class Generator>
+  constexpr void EmplaceBackN(size_t n, Generator&& generate) {
+    AppendWith(n, [&](Pointer gap) {
+      size_t built = 0;
       try {
-        AllocTraits::construct(alloc_, buffer_ + size_, std::forward<Args>(args)...);
-      } catch (...) {
-        AllocTraits::destroy(alloc_, buffer_ + size_);
-        throw;
-      }
-      ++size_;
-    } else {
-      auto backup_buff = buffer_;
-      auto backup_size = size_;
-      auto backup_capacity = capacity_;
-      if (capacity_ == 0) {
-        buffer_ = AllocTraits::allocate(alloc_, 1);
-        try {
-          AllocTraits::construct(alloc_, buffer_ + size_, std::forward<Args>(args)...);
-          capacity_ = 1;
-          ++size_;
-        } catch (...) {
-          size_ = backup_size;
-          capacity_ = backup_capacity;
-          AllocTraits::destroy(alloc_, buffer_ + size_);
-          AllocTraits::deallocate(alloc_, buffer_, 1);
-          buffer_ = backup_buff;
-          throw;
+        for (; built < n; ++built) {
+          AllocTraits::construct(alloc_, gap + built, generate());
         }
-      } else {
-        auto new_buff = AllocTraits::allocate(alloc_, capacity_ * 2);
-        try {
-          AllocTraits::construct(alloc_, new_buff + size_, std::forward<Args>(args)...);
-          MoveIterTo(begin(), end(), new_buff);
-          for (size_t i = 0; i < size_; i++) {
-            AllocTraits::destroy(alloc_, buffer_ + i);
-          }
-          AllocTraits::deallocate(alloc_, buffer_, capacity_);
-          buffer_ = new_buff;
-          capacity_ = capacity_ * 2;
-          ++size_;
-        } catch (...) {
-          size_ = backup_size;
-          capacity_ = backup_capacity;
-          AllocTraits::destroy(alloc_, new_buff + size_);
-          AllocTraits::deallocate(alloc_, new_buff, capacity_ * 2);
-          buffer_ = backup_buff;
-          throw;
+      } catch (...) {
+        for (size_t i = 0; i < built; i++) {
+          AllocTraits::destroy(alloc_, gap + i);
         }
+        throw;
       }
-    }
+    });
   }
 
-  void PushBack(const T& value) {
-    EmplaceBack(value);
-  }
-  void PushBack(T&& value) {
-    EmplaceBack(std::move(value));
-  }
-  void PopBack() noexcept(std::is_nothrow_destructible_v<ValueType>) {
-    if (!Empty()) {
-      --size_;
-      AllocTraits::destroy(alloc_, buffer_ + size_);
+  // Output iterator appending to the vector, see BackInserter. It keeps nothing but the
+  // vector, so that its copies stay interchangeable.
+  class BackInsertIterator {
+   public:
+    using iterator_category = std::output_iterator_tag;  // NOLINT
+    using value_type = void;  // NOLINT
+    using difference_type = ptrdiff_t;  // NOLINT
+    using pointer = void;  // NOLINT
+    using reference = void;  // NOLINT
+
+    constexpr BackInsertIterator(Vector& vec, size_t size_hint) : vec_(&vec) {
+      vec.ReserveMore(size_hint);
+    }
+
+    constexpr BackInsertIterator& operator=(const T& value) {
+      vec_->EmplaceBack(value);
+      return *this;
+    }
+    constexpr BackInsertIterator& operator=(T&& value) {
+      vec_->EmplaceBack(std::move(value));
+      return *this;
+    }
+    constexpr BackInsertIterator& operator*() noexcept {
+      return *this;
+    }
+    constexpr BackInsertIterator& operator++() noexcept {
+      return *this;
+    }
+    constexpr BackInsertIterator& operator++(int) noexcept {  // NOLINT
+      return *this;
     }
-  }
 
-  [[nodiscard]] ConstIterator cbegin() const noexcept {  // NOLINT
+   private:
+    Vector* vec_;
+  };
+
+  [[nodiscard]] constexpr ConstIterator cbegin() const noexcept {  // NOLINT
     return Data();
   }
-  [[nodiscard]] ConstIterator begin() const noexcept {  // NOLINT
+  [[nodiscard]] constexpr ConstIterator begin() const noexcept {  // NOLINT
     return cbegin();
   }
-  [[nodiscard]] Iterator begin() noexcept {  // NOLINT
+  [[nodiscard]] constexpr Iterator begin() noexcept {  // NOLINT
     return Data();
   }
-  [[nodiscard]] ConstIterator cend() const noexcept {  // NOLINT
+  [[nodiscard]] constexpr ConstIterator cend() const noexcept {  // NOLINT
     return Data() + size_;
   }
-  [[nodiscard]] ConstIterator end() const noexcept {  // NOLINT
+  [[nodiscard]] constexpr ConstIterator end() const noexcept {  // NOLINT
     return cend();
   }
-  [[nodiscard]] Iterator end() noexcept {  // NOLINT
+  [[nodiscard]] constexpr Iterator end() noexcept {  // NOLINT
     return Data() + size_;
   }
-  [[nodiscard]] ConstReverseIterator crbegin() const noexcept {  // NOLINT
+  [[nodiscard]] constexpr ConstReverseIterator crbegin() const noexcept {  // NOLINT
     return ConstReverseIterator(cend());
   }
-  [[nodiscard]] ConstReverseIterator rbegin() const noexcept {  // NOLINT
+  [[nodiscard]] constexpr ConstReverseIterator rbegin() const noexcept {  // NOLINT
     return crbegin();
   }
-  [[nodiscard]] ReverseIterator rbegin() noexcept {  // NOLINT
+  [[nodiscard]] constexpr ReverseIterator rbegin() noexcept {  // NOLINT
     return ReverseIterator(end());
   }
-  [[nodiscard]] ConstReverseIterator crend() const noexcept {  // NOLINT
+  [[nodiscard]] constexpr ConstReverseIterator crend() const noexcept {  // NOLINT
     return ConstReverseIterator(cbegin());
   }
-  [[nodiscard]] ConstReverseIterator rend() const noexcept {  // NOLINT
+  [[nodiscard]] constexpr ConstReverseIterator rend() const noexcept {  // NOLINT
     return crend();
   }
-  [[nodiscard]] ReverseIterator rend() noexcept {  // NOLINT
+  [[nodiscard]] constexpr ReverseIterator rend() noexcept {  // NOLINT
     return ReverseIterator(begin());
   }
 
  private:
   using AllocTraits = std::allocator_traits<Allocator>;
 
+  using ElementOps = vector_detail::ElementOps<T, Allocator>;
+  using PositionOps = vector_detail::PositionOps<T, Allocator>;
+  friend PositionOps;
+
+  static constexpr bool kPropagateOnCopy = AllocTraits::propagate_on_container_copy_assignment::value;
+  static constexpr bool kPropagateOnMove = AllocTraits::propagate_on_container_move_assignment::value;
+
+  static constexpr bool kBulkRelocation = ElementOps::kBulkRelocation;
+
+  // Changes the capacity without a separate allocate + relocate, through the allocator's
+  // try_expand (grows in place) or, when allow_move is set and elements are bulk-relocatable,
+  // reallocate hook. Returns false if neither applies or both fail; the buffer is then intact.
+  constexpr bool TryResizeBuffer(size_t new_capacity, bool allow_move) {
+    if (buffer_ == nullptr) {
+      return false;
+    }
+    if constexpr (vector_detail::HasTryExpand<Allocator>::value) {
+      if (new_capacity > capacity_ && alloc_.try_expand(buffer_, capacity_, new_capacity)) {
+        stats_.OnReallocate(0, new_capacity * sizeof(T));
+        capacity_ = new_capacity;
+        return true;
+      }
+    }
+    if constexpr (kBulkRelocation && vector_detail::HasReallocate<Allocator>::value) {
+      if (allow_move) {
+        if (auto new_buff = alloc_.reallocate(buffer_, capacity_, new_capacity)) {
+          stats_.OnReallocate(size_ * sizeof(T), new_capacity * sizeof(T));
+          buffer_ = new_buff;
+          capacity_ = new_capacity;
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  // Every new buffer comes from these two, so that the stats see all allocations.
+  [[nodiscard]] constexpr Pointer AllocateBuffer(size_t count) {
+    auto buffer = AllocTraits::allocate(alloc_, count);
+    stats_.OnAllocate(count * sizeof(T));
+    return buffer;
+  }
+  [[nodiscard]] constexpr vector_detail::AllocationResult<Allocator> AllocateAtLeast(size_t count) {
+    auto result = vector_detail::AllocateAtLeast(alloc_, count);
+    stats_.OnAllocate(result.count * sizeof(T));
+    return result;
+  }
+
+  // Swaps in a buffer the elements were just relocated to.
+  constexpr void ReplaceBuffer(Pointer new_buff, size_t new_capacity) noexcept {
+    if (capacity_ != 0) {
+      stats_.OnReallocate(size_ * sizeof(T), new_capacity * sizeof(T));
+    }
+    DeallocateBuffer();
+    buffer_ = new_buff;
+    capacity_ = new_capacity;
+  }
+
+  // The full-buffer half of EmplaceBack. For other than trivially copyable elements it is
+  // called out of line, so that the other half inlines.
+  template <class... Args>
+  [[gnu::cold, gnu::noinline]] constexpr void ColdGrowAndEmplaceBack(Args&&... args) {
+    GrowAndEmplaceBack(std::forward<Args>(args)...);
+  }
+  template <class... Args>
+  constexpr void GrowAndEmplaceBack(Args&&... args) {
+    [[maybe_unused]] const auto growth = stats_.TimeGrowth();
+    if constexpr (kBulkRelocation && vector_detail::HasReallocate<Allocator>::value) {
+      // reallocate may move the buffer, so the element is built aside in case args refer to it.
+      alignas(T) unsigned char storage[sizeof(T)];
+      auto value = reinterpret_cast<Pointer>(storage);
+      AllocTraits::construct(alloc_, value, std::forward<Args>(args)...);
+      try {
+        Reserve(GrowCapacity(size_ + 1));
+      } catch (...) {
+        AllocTraits::destroy(alloc_, value);
+        throw;
+      }
+      std::memcpy(static_cast<void*>(buffer_ + size_), static_cast<const void*>(value), sizeof(T));
+      ++size_;
+    } else if (TryResizeBuffer(GrowCapacity(size_ + 1), false)) {
+      AllocTraits::construct(alloc_, buffer_ + size_, std::forward<Args>(args)...);
+      ++size_;
+    } else {
+      auto [new_buff, new_capacity] = AllocateAtLeast(GrowCapacity(size_ + 1));
+      try {
+        AllocTraits::construct(alloc_, new_buff + size_, std::forward<Args>(args)...);
+      } catch (...) {
+        AllocTraits::deallocate(alloc_, new_buff, new_capacity);
+        throw;
+      }
+      try {
+        RelocateTo(new_buff);
+      } catch (...) {
+        AllocTraits::destroy(alloc_, new_buff + size_);
+        AllocTraits::deallocate(alloc_, new_buff, new_capacity);
+        throw;
+      }
+      ReplaceBuffer(new_buff, new_capacity);
+      ++size_;
+    }
+  }
+
+  // Makes room for count more elements, growing geometrically, so that repeated small hints
+  // stay amortized.
+  constexpr void ReserveMore(size_t count) {
+    if (count > capacity_ - size_) {
+      if (count > AllocTraits::max_size(alloc_) - size_) {
+        throw std::length_error("");
+      }
+      Reserve(GrowCapacity(size_ + count));
+    }
+  }
+
+  // Allocators need not accept the null pointer of an empty vector.
+  constexpr void DeallocateBuffer() noexcept {
+    if (buffer_ != nullptr) {
+      AllocTraits::deallocate(alloc_, buffer_, capacity_);
+    }
+  }
+
+  constexpr void SwapStorage(Vector& other) noexcept {
+    std::swap(buffer_, other.buffer_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+  // Takes other's buffer, and its allocator if that propagates on move assignment.
+  constexpr void StealFrom(Vector& other) noexcept {
+    Vector moved(std::move(other));
+    SwapStorage(moved);
+    if constexpr (kPropagateOnMove) {
+      std::swap(alloc_, moved.alloc_);
+    }
+  }
+
   template <typename MoveIterator>
-  void MoveIterRange(MoveIterator begin, MoveIterator end) {
+  constexpr void MoveIterRange(MoveIterator begin, MoveIterator end) {
     std::move_iterator<MoveIterator> mbegin(begin);
     std::move_iterator<MoveIterator> mend(end);
     CopyIterRange(mbegin, mend);
   }
 
   template <typename CopyIterator>
-  void CopyIterRange(CopyIterator begin, CopyIterator end) {
-    size_t curr_size = 0;
+  constexpr void CopyIterRange(CopyIterator begin, CopyIterator end) {
+    CopyIterTo(begin, end, buffer_);
+  }
+
+  template <typename CopyIterator>
+  constexpr void CopyIterTo(CopyIterator begin, CopyIterator end, Pointer buffer) {
+    ElementOps::CopyIterTo(alloc_, begin, end, buffer);
+  }
+
+  // Replaces the contents with `count` elements built by fill(new_buff) in a fresh buffer of
+  // exactly that capacity. fill must clean up after itself when it throws.
+  template <typename Filler>
+  constexpr void AssignToNewBuffer(size_t count, Filler&& fill) {
+    if (count > AllocTraits::max_size(alloc_)) {
+      throw std::length_error("");
+    }
+    auto new_buff = AllocateBuffer(count);
     try {
-      for (auto iter = begin; iter != end; ++iter) {
-        AllocTraits::construct(alloc_, buffer_ + curr_size, *iter);
-        ++curr_size;
-      }
+      fill(new_buff);
     } catch (...) {
-      for (size_t i = 0; i < curr_size; i++) {
-        AllocTraits::destroy(alloc_, buffer_ + i);
-      }
+      AllocTraits::deallocate(alloc_, new_buff, count);
       throw;
     }
+    for (size_t i = 0; i < size_; i++) {
+      AllocTraits::destroy(alloc_, buffer_ + i);
+    }
+    DeallocateBuffer();
+    buffer_ = new_buff;
+    size_ = count;
+    capacity_ = count;
+  }
+
+  constexpr void FillTo(Pointer buffer, size_t count, const T& value) {
+    ElementOps::FillTo(alloc_, buffer, count, value);
   }
 
   template <typename MoveIterator>
-  void MoveIterTo(MoveIterator begin, MoveIterator end, Pointer buffer) {
-    std::move_iterator<MoveIterator> mbegin(begin);
-    std::move_iterator<MoveIterator> mend(end);
-    auto curr_size = 0;
+  constexpr void MoveIterTo(MoveIterator begin, MoveIterator end, Pointer buffer) {
+    ElementOps::MoveIterTo(alloc_, begin, end, buffer);
+  }
+
+  [[nodiscard]] constexpr size_t GrowCapacity(size_t required) const {
+    return vector_detail::GrowCapacity<GrowthPolicy, T>(alloc_, capacity_, required);
+  }
+
+  // Moves the elements into buffer and ends their lifetime in buffer_. For trivially relocatable
+  // elements this is a single memcpy with no destroy pass.
+  constexpr void RelocateTo(Pointer buffer) {
+    ElementOps::RelocateTo(alloc_, buffer_, size_, buffer);
+  }
+
+  [[nodiscard]] constexpr bool IsElement(const T& value) const noexcept {
+    return PositionOps::IsElement(buffer_, size_, value);
+  }
+
+  // Resizes to `size`, building new elements with build(gap, count).
+  template <typename Builder>
+  constexpr void ResizeWith(size_t size, Builder&& build) {
+    if (size <= size_) {
+      ElementOps::Destroy(alloc_, buffer_ + size, size_ - size);
+      size_ = size;
+      return;
+    }
+    const size_t count = size - size_;
+    AppendWith(count, [&](Pointer gap) { build(gap, count); });
+  }
+
+  // Appends `count` elements built by build(gap) with at most one reallocation; strong
+  // guarantee as long as build cleans up after itself when it throws.
+  template <typename Builder>
+  constexpr void AppendWith(size_t count, Builder&& build) {
+    if (count == 0) {
+      return;
+    }
+    if (count <= capacity_ - size_) {
+      build(buffer_ + size_);
+      size_ += count;
+      return;
+    }
+    if (count > AllocTraits::max_size(alloc_) - size_) {
+      throw std::length_error("");
+    }
+    [[maybe_unused]] const auto growth = stats_.TimeGrowth();
+    if (TryResizeBuffer(GrowCapacity(size_ + count), false)) {
+      build(buffer_ + size_);
+      size_ += count;
+      return;
+    }
+    auto [new_buff, new_capacity] = AllocateAtLeast(GrowCapacity(size_ + count));
     try {
-      for (auto iter = mbegin; iter != mend; ++iter) {
-        AllocTraits::construct(alloc_, buffer + curr_size, *iter);
-        ++curr_size;
+      build(new_buff + size_);
+    } catch (...) {
+      AllocTraits::deallocate(alloc_, new_buff, new_capacity);
+      throw;
+    }
+    try {
+      RelocateTo(new_buff);
+    } catch (...) {
+      for (size_t i = size_; i < size_ + count; i++) {
+        AllocTraits::destroy(alloc_, new_buff + i);
       }
+      AllocTraits::deallocate(alloc_, new_buff, new_capacity);
+      throw;
+    }
+    ReplaceBuffer(new_buff, new_capacity);
+    size_ += count;
+  }
+
+  // Reallocation step of vector_detail::PositionOps.
+  template <typename Filler>
+  constexpr void ReallocateWith(size_t required, Filler&& fill) {
+    [[maybe_unused]] const auto growth = stats_.TimeGrowth();
+    auto [new_buff, new_capacity] = AllocateAtLeast(GrowCapacity(required));
+    try {
+      fill(new_buff);
     } catch (...) {
+      AllocTraits::deallocate(alloc_, new_buff, new_capacity);
       throw;
     }
+    ReplaceBuffer(new_buff, new_capacity);
   }
 
  private:
@@ -554,13 +1409,37 @@ class Vector {
   T* buffer_{nullptr};
   size_t size_{0};
   size_t capacity_{0};
+  [[no_unique_address]] vector_stats::Handle stats_;
 };
 
-template <typename T, class Alloc>
-[[nodiscard]] bool operator==(const Vector<T, Alloc>& lhs, const Vector<T, Alloc>& rhs) noexcept {
+// Removes the elements satisfying pred in a single compacting pass and returns their number.
+template <typename T, class Alloc, class Growth, class Predicate>
+constexpr size_t EraseIf(Vector<T, Alloc, Growth>& vec, Predicate pred) {
+  auto new_end = std::remove_if(vec.begin(), vec.end(), pred);
+  const auto count = static_cast<size_t>(vec.end() - new_end);
+  vec.Erase(new_end, vec.end());
+  return count;
+}
+
+// Like std::back_inserter, but reserves room for size_hint more elements first, so that
+// copying a range of known length into vec reallocates at most once.
+template <typename T, class Alloc, class Growth>
+[[nodiscard]] constexpr typename Vector<T, Alloc, Growth>::BackInsertIterator BackInserter(
+    Vector<T, Alloc, Growth>& vec, size_t size_hint = 0) {
+  return typename Vector<T, Alloc, Growth>::BackInsertIterator(vec, size_hint);
+}
+
+template <typename T, class Alloc, class Growth>
+[[nodiscard]] constexpr bool operator==(const Vector<T, Alloc, Growth>& lhs,
+                                        const Vector<T, Alloc, Growth>& rhs) noexcept {
   if (lhs.Size() != rhs.Size()) {
     return false;
   }
+  if constexpr (vector_simd::kAccelerated<T>) {
+    if (!std::is_constant_evaluated()) {
+      return vector_simd::Equal(lhs.Data(), rhs.Data(), lhs.Size());
+    }
+  }
   for (size_t i = 0; i < lhs.Size(); ++i) {
     if (lhs[i] != rhs[i]) {
       return false;
@@ -569,29 +1448,46 @@ template <typename T, class Alloc>
   return true;
 }
 
-template <typename T, class Alloc>
-[[nodiscard]] bool operator<(const Vector<T, Alloc>& lhs, const Vector<T, Alloc>& rhs) noexcept {
+template <typename T, class Alloc, class Growth>
+[[nodiscard]] constexpr bool operator<(const Vector<T, Alloc, Growth>& lhs,
+                                       const Vector<T, Alloc, Growth>& rhs) noexcept {
+  if constexpr (vector_simd::kAccelerated<T>) {
+    if (!std::is_constant_evaluated()) {
+      return vector_simd::Less(lhs.Data(), lhs.Size(), rhs.Data(), rhs.Size());
+    }
+  }
   return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename T, class Alloc>
-[[nodiscard]] bool operator!=(const Vector<T, Alloc>& lhs, const Vector<T, Alloc>& rhs) noexcept {
+template <typename T, class Alloc, class Growth>
+[[nodiscard]] constexpr bool operator!=(const Vector<T, Alloc, Growth>& lhs,
+                                        const Vector<T, Alloc, Growth>& rhs) noexcept {
   return !(lhs == rhs);
 }
 
-template <typename T, class Alloc>
-[[nodiscard]] bool operator>(const Vector<T, Alloc>& lhs, const Vector<T, Alloc>& rhs) noexcept {
+template <typename T, class Alloc, class Growth>
+[[nodiscard]] constexpr bool operator>(const Vector<T, Alloc, Growth>& lhs,
+                                       const Vector<T, Alloc, Growth>& rhs) noexcept {
   return rhs < lhs;
 }
 
-template <typename T, class Alloc>
-[[nodiscard]] bool operator<=(const Vector<T, Alloc>& lhs, const Vector<T, Alloc>& rhs) noexcept {
+template <typename T, class Alloc, class Growth>
+[[nodiscard]] constexpr bool operator<=(const Vector<T, Alloc, Growth>& lhs,
+                                        const Vector<T, Alloc, Growth>& rhs) noexcept {
   return !(lhs > rhs);
 }
 
-template <typename T, class Alloc>
-[[nodiscard]] bool operator>=(const Vector<T, Alloc>& lhs, const Vector<T, Alloc>& rhs) noexcept {
+template <typename T, class Alloc, class Growth>
+[[nodiscard]] constexpr bool operator>=(const Vector<T, Alloc, Growth>& lhs,
+                                        const Vector<T, Alloc, Growth>& rhs) noexcept {
   return !(lhs < rhs);
 }
 
+namespace pmr {
+
+template <typename T, class GrowthPolicy = DoublingGrowth>
+using Vector = ::Vector<T, std::pmr::polymorphic_allocator<T>, GrowthPolicy>;
+
+}  // namespace pmr
+
 #endif  // OOP_ASSIGNMENTS_VECTOR_VECTOR_H_
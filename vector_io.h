@@ -0,0 +1,353 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_VECTOR_IO_H_
+#define OOP_ASSIGNMENTS_VECTOR_VECTOR_IO_H_
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <system_error>
+
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "vector_view.h"
+
+// Serialized form of a vector: this header, padded to kPayloadOffset bytes, then the elements
+// as they lie in Data(). Nested vectors store the inner sizes as uint64_t before the elements.
+// MappedVector uses the same layout, so a written snapshot can be mapped directly.
+struct VectorFileHeader {
+  static constexpr char kMagic[8] = {'C', 'V', 'E', 'C', 'T', 'O', 'R', '\0'};
+  static constexpr uint32_t kVersion = 1;
+  static constexpr uint32_t kByteOrderMark = 0x01020304;
+  static constexpr size_t kPayloadOffset = 64;
+  static constexpr uint64_t kNested = 1;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint64_t element_size;
+  uint64_t alignment;
+  uint64_t count;
+  uint64_t flags;
+};
+
+static_assert(sizeof(VectorFileHeader) <= VectorFileHeader::kPayloadOffset);
+
+namespace vector_io_detail {
+
+#ifdef IOV_MAX
+inline constexpr int kMaxIovecs = IOV_MAX;
+#else
+inline constexpr int kMaxIovecs = 1024;
+#endif
+
+struct HeaderBlock {
+  alignas(VectorFileHeader) unsigned char bytes[VectorFileHeader::kPayloadOffset];
+};
+
+template <typename T>
+[[nodiscard]] HeaderBlock MakeHeader(size_t count, uint64_t flags) noexcept {
+  VectorFileHeader header{};
+  std::memcpy(header.magic, VectorFileHeader::kMagic, sizeof(header.magic));
+  header.version = VectorFileHeader::kVersion;
+  header.byte_order = VectorFileHeader::kByteOrderMark;
+  header.element_size = sizeof(T);
+  header.alignment = alignof(T);
+  header.count = count;
+  header.flags = flags;
+  HeaderBlock block{};
+  std::memcpy(block.bytes, &header, sizeof(header));
+  return block;
+}
+
+template <typename T>
+[[nodiscard]] VectorFileHeader CheckHeader(const void* bytes, uint64_t flags) {
+  VectorFileHeader header;
+  std::memcpy(&header, bytes, sizeof(header));
+  if (std::memcmp(header.magic, VectorFileHeader::kMagic, sizeof(header.magic)) != 0 ||
+      header.version != VectorFileHeader::kVersion || header.byte_order != VectorFileHeader::kByteOrderMark) {
+    throw std::runtime_error("not a vector file of this version and byte order");
+  }
+  if (header.element_size != sizeof(T) || header.alignment != alignof(T) || header.flags != flags) {
+    throw std::runtime_error("vector file holds a different element type");
+  }
+  return header;
+}
+
+// Writes all of `iov`, resuming after short writes.
+inline void WriteAll(int fd, iovec* iov, size_t count) {
+  while (count > 0) {
+    const ssize_t written = ::writev(fd, iov, static_cast<int>(std::min<size_t>(count, kMaxIovecs)));
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::system_error(errno, std::generic_category(), "writev");
+    }
+    auto left = static_cast<size_t>(written);
+    while (count > 0 && left >= iov->iov_len) {
+      left -= iov->iov_len;
+      ++iov;
+      --count;
+    }
+    if (count > 0) {
+      iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+      iov->iov_len -= left;
+    }
+  }
+}
+
+inline void ReadAll(int fd, iovec* iov, size_t count) {
+  while (count > 0) {
+    const ssize_t received = ::readv(fd, iov, static_cast<int>(std::min<size_t>(count, kMaxIovecs)));
+    if (received < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::system_error(errno, std::generic_category(), "readv");
+    }
+    if (received == 0) {
+      throw std::runtime_error("vector file is truncated");
+    }
+    auto left = static_cast<size_t>(received);
+    while (count > 0 && left >= iov->iov_len) {
+      left -= iov->iov_len;
+      ++iov;
+      --count;
+    }
+    if (count > 0) {
+      iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+      iov->iov_len -= left;
+    }
+  }
+}
+
+inline void ReadAll(int fd, void* buffer, size_t bytes) {
+  iovec iov{buffer, bytes};
+  ReadAll(fd, &iov, 1);
+}
+
+inline void WriteStream(std::ostream& os, const void* buffer, size_t bytes) {
+  if (!os.write(static_cast<const char*>(buffer), static_cast<std::streamsize>(bytes))) {
+    throw std::ios_base::failure("vector write failed");
+  }
+}
+
+inline void ReadStream(std::istream& is, void* buffer, size_t bytes) {
+  if (!is.read(static_cast<char*>(buffer), static_cast<std::streamsize>(bytes))) {
+    throw std::runtime_error("vector file is truncated");
+  }
+}
+
+inline constexpr size_t kUnknownBytes = static_cast<size_t>(-1);
+
+// Bytes between the file offset of fd and the end of the file, or kUnknownBytes for pipes,
+// sockets and other descriptors without a size.
+[[nodiscard]] inline size_t BytesLeft(int fd) noexcept {
+  struct stat info {};
+  if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+    return kUnknownBytes;
+  }
+  const off_t offset = ::lseek(fd, 0, SEEK_CUR);
+  if (offset < 0 || offset > info.st_size) {
+    return kUnknownBytes;
+  }
+  return static_cast<size_t>(info.st_size - offset);
+}
+
+// Rejects counts that the allocator or the rest of the file cannot hold before anything is
+// allocated for them.
+template <typename T, class Alloc>
+[[nodiscard]] size_t CheckCount(uint64_t count, const Alloc& alloc, size_t bytes_left) {
+  if (count > std::allocator_traits<Alloc>::max_size(alloc)) {
+    throw std::runtime_error("vector file holds more elements than fit in memory");
+  }
+  if (bytes_left != kUnknownBytes && count > bytes_left / sizeof(T)) {
+    throw std::runtime_error("vector file is truncated");
+  }
+  return static_cast<size_t>(count);
+}
+
+// Steps of at least this many bytes when the size of the input is unknown.
+inline constexpr size_t kMinReadStep = size_t{64} << 10;
+
+// Reads count elements into `vector` with read(buffer, bytes). Unless the input is known to
+// hold them, the buffer grows by at most what has already arrived, so a corrupt count in a
+// pipe or stream runs out of input instead of allocating all of it up front.
+template <typename Vec, typename Reader>
+void ReadElements(Vec& vector, size_t count, size_t bytes_left, Reader read) {
+  using T = typename Vec::ValueType;
+  while (vector.Size() < count) {
+    const size_t done = vector.Size();
+    size_t step = count - done;
+    if (bytes_left == kUnknownBytes) {
+      step = std::min(step, std::max({done, kMinReadStep / sizeof(T), size_t{1}}));
+    }
+    vector.ResizeDefaultInit(done + step);
+    read(vector.Data() + done, step * sizeof(T));
+  }
+}
+
+}  // namespace vector_io_detail
+
+// Writes the header and the payload with a single writev.
+template <typename T, class Alloc, class Growth>
+void WriteTo(int fd, const Vector<T, Alloc, Growth>& vector) {
+  static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can be serialized");
+  auto header = vector_io_detail::MakeHeader<T>(vector.Size(), 0);
+  iovec iov[] = {{header.bytes, sizeof(header.bytes)},
+                 {const_cast<T*>(vector.Data()), vector.Size() * sizeof(T)}};
+  vector_io_detail::WriteAll(fd, iov, vector.Empty() ? 1 : 2);
+}
+
+// Gathers the header, the inner sizes and every inner payload into as few writev calls as the
+// system allows.
+template <typename T, class InnerAlloc, class InnerGrowth, class Alloc, class Growth>
+void WriteTo(int fd, const Vector<Vector<T, InnerAlloc, InnerGrowth>, Alloc, Growth>& vectors) {
+  static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can be serialized");
+  auto header = vector_io_detail::MakeHeader<T>(vectors.Size(), VectorFileHeader::kNested);
+  Vector<uint64_t> sizes(vectors.Size(), kDefaultInit);
+  Vector<iovec> iov;
+  iov.Reserve(vectors.Size() + 2);
+  iov.PushBack({header.bytes, sizeof(header.bytes)});
+  iov.PushBack({sizes.Data(), sizes.Size() * sizeof(uint64_t)});
+  for (size_t i = 0; i < vectors.Size(); ++i) {
+    sizes[i] = vectors[i].Size();
+    if (!vectors[i].Empty()) {
+      iov.PushBack({const_cast<T*>(vectors[i].Data()), vectors[i].Size() * sizeof(T)});
+    }
+  }
+  vector_io_detail::WriteAll(fd, iov.Data(), iov.Size());
+}
+
+// Replaces the contents of `vector`; leaves it untouched if reading fails. The header count
+// is checked against the size of a regular file before the buffer is allocated.
+template <typename T, class Alloc, class Growth>
+void ReadFrom(int fd, Vector<T, Alloc, Growth>& vector) {
+  static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can be serialized");
+  vector_io_detail::HeaderBlock block;
+  vector_io_detail::ReadAll(fd, block.bytes, sizeof(block.bytes));
+  const auto header = vector_io_detail::CheckHeader<T>(block.bytes, 0);
+  const size_t bytes_left = vector_io_detail::BytesLeft(fd);
+  const size_t count = vector_io_detail::CheckCount<T>(header.count, vector.GetAllocator(), bytes_left);
+  Vector<T, Alloc, Growth> result(vector.GetAllocator());
+  vector_io_detail::ReadElements(result, count, bytes_left,
+                                 [fd](void* buffer, size_t bytes) { vector_io_detail::ReadAll(fd, buffer, bytes); });
+  vector.Swap(result);
+}
+
+template <typename T, class InnerAlloc, class InnerGrowth, class Alloc, class Growth>
+void ReadFrom(int fd, Vector<Vector<T, InnerAlloc, InnerGrowth>, Alloc, Growth>& vectors) {
+  static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can be serialized");
+  using Inner = Vector<T, InnerAlloc, InnerGrowth>;
+  const auto read = [fd](void* buffer, size_t bytes) { vector_io_detail::ReadAll(fd, buffer, bytes); };
+  vector_io_detail::HeaderBlock block;
+  vector_io_detail::ReadAll(fd, block.bytes, sizeof(block.bytes));
+  const auto header = vector_io_detail::CheckHeader<T>(block.bytes, VectorFileHeader::kNested);
+  size_t bytes_left = vector_io_detail::BytesLeft(fd);
+  const size_t count = vector_io_detail::CheckCount<uint64_t>(header.count, vectors.GetAllocator(), bytes_left);
+  Vector<uint64_t> sizes;
+  vector_io_detail::ReadElements(sizes, count, bytes_left, read);
+  Vector<Inner, Alloc, Growth> result(vectors.GetAllocator());
+  result.Resize(count);
+  if (bytes_left == vector_io_detail::kUnknownBytes) {
+    for (size_t i = 0; i < count; ++i) {
+      const size_t size = vector_io_detail::CheckCount<T>(sizes[i], result[i].GetAllocator(), bytes_left);
+      vector_io_detail::ReadElements(result[i], size, bytes_left, read);
+    }
+  } else {
+    // Every inner size is checked against what the file still holds, so their sum is too.
+    bytes_left -= count * sizeof(uint64_t);
+    Vector<iovec> iov;
+    iov.Reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      if (sizes[i] != 0) {
+        result[i].ResizeDefaultInit(vector_io_detail::CheckCount<T>(sizes[i], result[i].GetAllocator(), bytes_left));
+        bytes_left -= result[i].Size() * sizeof(T);
+        iov.PushBack({result[i].Data(), result[i].Size() * sizeof(T)});
+      }
+    }
+    vector_io_detail::ReadAll(fd, iov.Data(), iov.Size());
+  }
+  vectors.Swap(result);
+}
+
+template <typename T, class Alloc, class Growth>
+void WriteTo(std::ostream& os, const Vector<T, Alloc, Growth>& vector) {
+  static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can be serialized");
+  const auto header = vector_io_detail::MakeHeader<T>(vector.Size(), 0);
+  vector_io_detail::WriteStream(os, header.bytes, sizeof(header.bytes));
+  vector_io_detail::WriteStream(os, vector.Data(), vector.Size() * sizeof(T));
+}
+
+template <typename T, class InnerAlloc, class InnerGrowth, class Alloc, class Growth>
+void WriteTo(std::ostream& os, const Vector<Vector<T, InnerAlloc, InnerGrowth>, Alloc, Growth>& vectors) {
+  static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can be serialized");
+  const auto header = vector_io_detail::MakeHeader<T>(vectors.Size(), VectorFileHeader::kNested);
+  vector_io_detail::WriteStream(os, header.bytes, sizeof(header.bytes));
+  for (const auto& vector : vectors) {
+    const uint64_t size = vector.Size();
+    vector_io_detail::WriteStream(os, &size, sizeof(size));
+  }
+  for (const auto& vector : vectors) {
+    vector_io_detail::WriteStream(os, vector.Data(), vector.Size() * sizeof(T));
+  }
+}
+
+// Streams give no size to check the header against, so the buffers grow as the elements arrive.
+template <typename T, class Alloc, class Growth>
+void ReadFrom(std::istream& is, Vector<T, Alloc, Growth>& vector) {
+  static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can be serialized");
+  vector_io_detail::HeaderBlock block;
+  vector_io_detail::ReadStream(is, block.bytes, sizeof(block.bytes));
+  const auto header = vector_io_detail::CheckHeader<T>(block.bytes, 0);
+  const size_t count =
+      vector_io_detail::CheckCount<T>(header.count, vector.GetAllocator(), vector_io_detail::kUnknownBytes);
+  Vector<T, Alloc, Growth> result(vector.GetAllocator());
+  vector_io_detail::ReadElements(result, count, vector_io_detail::kUnknownBytes,
+                                 [&is](void* buffer, size_t bytes) { vector_io_detail::ReadStream(is, buffer, bytes); });
+  vector.Swap(result);
+}
+
+template <typename T, class InnerAlloc, class InnerGrowth, class Alloc, class Growth>
+void ReadFrom(std::istream& is, Vector<Vector<T, InnerAlloc, InnerGrowth>, Alloc, Growth>& vectors) {
+  static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can be serialized");
+  constexpr size_t kUnknown = vector_io_detail::kUnknownBytes;
+  const auto read = [&is](void* buffer, size_t bytes) { vector_io_detail::ReadStream(is, buffer, bytes); };
+  vector_io_detail::HeaderBlock block;
+  vector_io_detail::ReadStream(is, block.bytes, sizeof(block.bytes));
+  const auto header = vector_io_detail::CheckHeader<T>(block.bytes, VectorFileHeader::kNested);
+  const size_t count = vector_io_detail::CheckCount<uint64_t>(header.count, vectors.GetAllocator(), kUnknown);
+  Vector<uint64_t> sizes;
+  vector_io_detail::ReadElements(sizes, count, kUnknown, read);
+  Vector<Vector<T, InnerAlloc, InnerGrowth>, Alloc, Growth> result(vectors.GetAllocator());
+  result.Resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    const size_t size = vector_io_detail::CheckCount<T>(sizes[i], result[i].GetAllocator(), kUnknown);
+    vector_io_detail::ReadElements(result[i], size, kUnknown, read);
+  }
+  vectors.Swap(result);
+}
+
+// Views the elements of a serialized buffer without copying them. The buffer has to stay alive
+// and be aligned for T, as buffers returned by malloc or mmap are.
+template <typename T>
+[[nodiscard]] ConstVectorView<T> ViewFrom(const void* buffer, size_t bytes) {
+  static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can be serialized");
+  if (bytes < VectorFileHeader::kPayloadOffset) {
+    throw std::runtime_error("vector file is truncated");
+  }
+  const auto header = vector_io_detail::CheckHeader<T>(buffer, 0);
+  if (header.count > (bytes - VectorFileHeader::kPayloadOffset) / sizeof(T)) {
+    throw std::runtime_error("vector file is truncated");
+  }
+  const auto payload = static_cast<const unsigned char*>(buffer) + VectorFileHeader::kPayloadOffset;
+  if (reinterpret_cast<std::uintptr_t>(payload) % alignof(T) != 0) {
+    throw std::runtime_error("vector buffer is misaligned");
+  }
+  return {reinterpret_cast<const T*>(payload), static_cast<size_t>(header.count)};
+}
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_VECTOR_IO_H_
@@ -0,0 +1,242 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_VECTOR_PARALLEL_H_
+#define OOP_ASSIGNMENTS_VECTOR_VECTOR_PARALLEL_H_
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+
+#include "thread_pool.h"
+#include "vector.h"
+
+// Bulk operations that split a Vector's buffer into chunks on a ThreadPool. Buffers smaller
+// than kParallelMinBytes are processed on the calling thread. Elements are only constructed
+// concurrently when the allocator's construct is plain placement new (AllowsTrivialRelocation);
+// other allocators are driven serially.
+inline constexpr size_t kParallelMinBytes = size_t{1} << 20;
+
+namespace vector_parallel_detail {
+
+inline constexpr size_t kCacheLine = 64;
+
+// Splits [0, count) into a few chunks per thread; inner boundaries fall on cache lines of data
+// whenever the element size allows, so that no two threads write to the same line.
+class ChunkPlan {
+ public:
+  template <typename T>
+  ChunkPlan(const T* data, size_t count, size_t concurrency) noexcept : count_(count) {
+    const size_t line = kCacheLine % sizeof(T) == 0 ? kCacheLine / sizeof(T) : 1;
+    const size_t target = std::max(count / (4 * concurrency), kParallelMinBytes / 16 / sizeof(T) + 1);
+    grain_ = (target + line - 1) / line * line;
+    const auto misalignment = reinterpret_cast<std::uintptr_t>(data) % kCacheLine;
+    if (line > 1 && misalignment % sizeof(T) == 0) {
+      first_ = (kCacheLine - misalignment) % kCacheLine / sizeof(T);
+    }
+    chunks_ = first_ + grain_ >= count ? 1 : 1 + (count - first_ - 1) / grain_;
+  }
+
+  [[nodiscard]] size_t Size() const noexcept {
+    return chunks_;
+  }
+  [[nodiscard]] size_t Begin(size_t chunk) const noexcept {
+    return chunk == 0 ? 0 : first_ + chunk * grain_;
+  }
+  [[nodiscard]] size_t End(size_t chunk) const noexcept {
+    return std::min(count_, first_ + (chunk + 1) * grain_);
+  }
+
+ private:
+  size_t count_;
+  size_t first_{0};
+  size_t grain_;
+  size_t chunks_;
+};
+
+template <typename T>
+[[nodiscard]] bool RunsInParallel(size_t count, const ThreadPool& pool) noexcept {
+  return count * sizeof(T) >= kParallelMinBytes && pool.Concurrency() > 1;
+}
+
+// Runs build(begin, end) over chunks of [0, count). Each build constructs its range and cleans
+// it up itself if it throws; the chunks that did complete are destroyed here before rethrowing.
+template <typename T, class Allocator, class Builder>
+void ParallelConstruct(ThreadPool& pool, Allocator& alloc, T* buffer, size_t count, Builder&& build) {
+  if (!kAllowsTrivialRelocationV<Allocator> || !RunsInParallel<T>(count, pool)) {
+    build(0, count);
+    return;
+  }
+  const ChunkPlan plan(buffer, count, pool.Concurrency());
+  Vector<unsigned char> built(plan.Size(), static_cast<unsigned char>(0));
+  try {
+    pool.Run(plan.Size(), [&](size_t chunk) {
+      build(plan.Begin(chunk), plan.End(chunk));
+      built[chunk] = 1;
+    });
+  } catch (...) {
+    for (size_t chunk = 0; chunk < plan.Size(); ++chunk) {
+      if (built[chunk] != 0) {
+        vector_detail::ElementOps<T, Allocator>::Destroy(alloc, buffer + plan.Begin(chunk),
+                                                         plan.End(chunk) - plan.Begin(chunk));
+      }
+    }
+    throw;
+  }
+}
+
+// Runs body(begin, end) over chunks of [0, count) of data.
+template <typename T, class Body>
+void ParallelChunks(ThreadPool& pool, const T* data, size_t count, Body&& body) {
+  if (!RunsInParallel<T>(count, pool)) {
+    body(0, count);
+    return;
+  }
+  const ChunkPlan plan(data, count, pool.Concurrency());
+  pool.Run(plan.Size(), [&](size_t chunk) { body(plan.Begin(chunk), plan.End(chunk)); });
+}
+
+}  // namespace vector_parallel_detail
+
+// Replaces the contents with count copies of value, like Assign(count, value).
+template <typename T, class Alloc, class Growth>
+void ParallelFill(Vector<T, Alloc, Growth>& vec, size_t count, const T& value,
+                  ThreadPool& pool = ThreadPool::Default()) {
+  const T copy(value);
+  vec.Clear();
+  vec.Reserve(count);
+  auto alloc = vec.GetAllocator();
+  vec.ResizeForOverwrite(count, [&](T* buffer, size_t size) {
+    vector_parallel_detail::ParallelConstruct(pool, alloc, buffer, size, [&](size_t begin, size_t end) {
+      vector_detail::ElementOps<T, Alloc>::FillTo(alloc, buffer + begin, end - begin, copy);
+    });
+    return size;
+  });
+}
+
+// Like Resize(size, value), constructing the new elements in parallel.
+template <typename T, class Alloc, class Growth>
+void ParallelResize(Vector<T, Alloc, Growth>& vec, size_t size, const T& value,
+                    ThreadPool& pool = ThreadPool::Default()) {
+  if (size <= vec.Size()) {
+    vec.Resize(size, value);
+    return;
+  }
+  const T copy(value);
+  const size_t old_size = vec.Size();
+  auto alloc = vec.GetAllocator();
+  vec.ResizeForOverwrite(size, [&](T* buffer, size_t new_size) {
+    T* tail = buffer + old_size;
+    vector_parallel_detail::ParallelConstruct(pool, alloc, tail, new_size - old_size, [&](size_t begin, size_t end) {
+      vector_detail::ElementOps<T, Alloc>::FillTo(alloc, tail + begin, end - begin, copy);
+    });
+    return new_size;
+  });
+}
+
+// Copy of other built in parallel, with the allocator the copy constructor would pick.
+template <typename T, class Alloc, class Growth>
+[[nodiscard]] Vector<T, Alloc, Growth> ParallelCopy(const Vector<T, Alloc, Growth>& other,
+                                                   ThreadPool& pool = ThreadPool::Default()) {
+  Vector<T, Alloc, Growth> result(
+      std::allocator_traits<Alloc>::select_on_container_copy_construction(other.GetAllocator()));
+  result.Reserve(other.Size());
+  auto alloc = result.GetAllocator();
+  result.ResizeForOverwrite(other.Size(), [&](T* buffer, size_t size) {
+    vector_parallel_detail::ParallelConstruct(pool, alloc, buffer, size, [&](size_t begin, size_t end) {
+      vector_detail::ElementOps<T, Alloc>::CopyIterTo(alloc, other.begin() + begin, other.begin() + end,
+                                                      buffer + begin);
+    });
+    return size;
+  });
+  return result;
+}
+
+// Replaces every element x with op(x).
+template <typename T, class Alloc, class Growth, class UnaryOp>
+void ParallelTransform(Vector<T, Alloc, Growth>& vec, UnaryOp op, ThreadPool& pool = ThreadPool::Default()) {
+  T* data = vec.Data();
+  vector_parallel_detail::ParallelChunks(pool, data, vec.Size(), [&](size_t begin, size_t end) {
+    std::transform(data + begin, data + end, data + begin, op);
+  });
+}
+
+// Replaces the contents of dst with op(x) for every x in src, constructed in place.
+template <typename T, class Alloc, class Growth, typename U, class DstAlloc, class DstGrowth, class UnaryOp>
+void ParallelTransform(const Vector<T, Alloc, Growth>& src, Vector<U, DstAlloc, DstGrowth>& dst, UnaryOp op,
+                       ThreadPool& pool = ThreadPool::Default()) {
+  using AllocTraits = std::allocator_traits<DstAlloc>;
+  dst.Clear();
+  dst.Reserve(src.Size());
+  auto alloc = dst.GetAllocator();
+  const T* from = src.Data();
+  dst.ResizeForOverwrite(src.Size(), [&](U* buffer, size_t size) {
+    vector_parallel_detail::ParallelConstruct(pool, alloc, buffer, size, [&](size_t begin, size_t end) {
+      size_t curr = begin;
+      try {
+        for (; curr < end; ++curr) {
+          AllocTraits::construct(alloc, buffer + curr, op(from[curr]));
+        }
+      } catch (...) {
+        vector_detail::ElementOps<U, DstAlloc>::Destroy(alloc, buffer + begin, curr - begin);
+        throw;
+      }
+    });
+    return size;
+  });
+}
+
+// Sorts chunks in parallel and merges them pairwise; not stable.
+template <typename T, class Alloc, class Growth, class Compare = std::less<>>
+void ParallelSort(Vector<T, Alloc, Growth>& vec, Compare comp = Compare(), ThreadPool& pool = ThreadPool::Default()) {
+  T* data = vec.Data();
+  const size_t count = vec.Size();
+  if (!vector_parallel_detail::RunsInParallel<T>(count, pool)) {
+    std::sort(data, data + count, comp);
+    return;
+  }
+  const vector_parallel_detail::ChunkPlan plan(data, count, pool.Concurrency());
+  pool.Run(plan.Size(), [&](size_t chunk) { std::sort(data + plan.Begin(chunk), data + plan.End(chunk), comp); });
+  for (size_t width = 1; width < plan.Size(); width *= 2) {
+    const size_t merges = (plan.Size() + 2 * width - 1) / (2 * width);
+    pool.Run(merges, [&](size_t merge) {
+      const size_t first = merge * 2 * width;
+      const size_t middle = first + width;
+      if (middle < plan.Size()) {
+        const size_t last = std::min(plan.Size(), middle + width);
+        std::inplace_merge(data + plan.Begin(first), data + plan.Begin(middle), data + plan.End(last - 1), comp);
+      }
+    });
+  }
+}
+
+// Folds the elements with op, which has to be associative; chunk results are combined in order.
+// As with std::reduce, the parallel path needs a homogeneous op: each chunk after the first
+// starts from Result(element) and chunk results are folded with op(Result, Result). Other ops,
+// such as (size_t, const std::string&), run serially like std::accumulate.
+template <typename T, class Alloc, class Growth, typename Result, class BinaryOp = std::plus<>>
+[[nodiscard]] Result ParallelReduce(const Vector<T, Alloc, Growth>& vec, Result init, BinaryOp op = BinaryOp(),
+                                    ThreadPool& pool = ThreadPool::Default()) {
+  constexpr bool kHomogeneous = std::is_constructible_v<Result, const T&> &&
+                                std::is_invocable_r_v<Result, BinaryOp&, Result, const T&> &&
+                                std::is_invocable_r_v<Result, BinaryOp&, Result, Result>;
+  const T* data = vec.Data();
+  if constexpr (!kHomogeneous) {
+    return std::accumulate(data, data + vec.Size(), std::move(init), op);
+  } else {
+    if (!vector_parallel_detail::RunsInParallel<T>(vec.Size(), pool)) {
+      return std::accumulate(data, data + vec.Size(), std::move(init), op);
+    }
+    const vector_parallel_detail::ChunkPlan plan(data, vec.Size(), pool.Concurrency());
+    Vector<Result> partial(plan.Size(), init);
+    pool.Run(plan.Size(), [&](size_t chunk) {
+      const T* first = data + plan.Begin(chunk);
+      const T* last = data + plan.End(chunk);
+      partial[chunk] = chunk == 0 ? std::accumulate(first, last, std::move(partial[0]), op)
+                                  : std::accumulate(first + 1, last, Result(*first), op);
+    });
+    for (size_t chunk = 1; chunk < partial.Size(); ++chunk) {
+      partial[0] = op(std::move(partial[0]), std::move(partial[chunk]));
+    }
+    return std::move(partial[0]);
+  }
+}
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_VECTOR_PARALLEL_H_
@@ -0,0 +1,394 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_VECTOR_SIMD_H_
+#define OOP_ASSIGNMENTS_VECTOR_VECTOR_SIMD_H_
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+// Comparison and search kernels for arithmetic element types. They are written with GCC vector
+// extensions; on x86-64 the widest of SSE2, AVX2 and AVX-512 is picked at run time, on AArch64
+// they compile to NEON. Define VECTOR_NO_SIMD to get the scalar loops only.
+#if defined(__GNUC__) && !defined(VECTOR_NO_SIMD)
+#define VECTOR_SIMD_ENABLED 1
+#if defined(__x86_64__) || defined(__i386__)
+#define VECTOR_SIMD_X86 1
+#endif
+#endif
+
+namespace vector_simd {
+
+// Types the kernels handle lane-wise.
+template <typename T>
+inline constexpr bool kVectorizable = (std::is_integral_v<T> && !std::is_same_v<T, bool>) ||
+                                      std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+// Types whose ordering is the ordering of their bytes, so that memcmp compares ranges of them.
+template <typename T>
+inline constexpr bool kBytewiseOrdered = std::is_same_v<T, bool> || std::is_same_v<T, unsigned char> ||
+#if defined(__cpp_char8_t)
+                                         std::is_same_v<T, char8_t> ||
+#endif
+                                         (std::is_same_v<T, char> && std::is_unsigned_v<char>);
+
+template <typename T>
+inline constexpr bool kAccelerated = kVectorizable<T> || kBytewiseOrdered<T>;
+
+namespace detail {
+
+#if defined(VECTOR_SIMD_ENABLED)
+
+// Wide vectors only cross always_inline helpers, so the ABI of passing them does not matter.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+template <size_t Size>
+using UnsignedOfSize = std::conditional_t<
+    Size == 1, uint8_t, std::conditional_t<Size == 2, uint16_t, std::conditional_t<Size == 4, uint32_t, uint64_t>>>;
+
+template <size_t Width, typename T>
+struct Lanes {
+  typedef T Vec __attribute__((vector_size(Width)));  // NOLINT
+  // uint64_t spelled as a dependent type, which GCC needs to apply a dependent vector_size.
+  typedef std::enable_if_t<Width % 8 == 0, uint64_t> Words __attribute__((vector_size(Width)));  // NOLINT
+  typedef UnsignedOfSize<sizeof(T)> Counters __attribute__((vector_size(Width)));  // NOLINT
+  static constexpr size_t kCount = Width / sizeof(T);
+
+  [[gnu::always_inline]] static Vec Load(const T* ptr) noexcept {
+    Vec vec;
+    std::memcpy(&vec, ptr, sizeof(vec));
+    return vec;
+  }
+  [[gnu::always_inline]] static Vec Broadcast(T value) noexcept {
+    Vec vec;
+    for (size_t i = 0; i < kCount; ++i) {
+      vec[i] = value;
+    }
+    return vec;
+  }
+  template <class Mask>
+  [[gnu::always_inline]] static bool Any(const Mask& mask) noexcept {
+    const Words words = (Words)mask;  // NOLINT
+    uint64_t any = 0;
+    for (size_t i = 0; i < Width / 8; ++i) {
+      any |= words[i];
+    }
+    return any != 0;
+  }
+  // Sum of per-lane counters, each of which may have reached its maximum.
+  [[gnu::always_inline]] static size_t Sum(const Counters& counters) noexcept {
+    size_t sum = 0;
+    for (size_t i = 0; i < kCount; ++i) {
+      sum += counters[i];
+    }
+    return sum;
+  }
+};
+
+// On a hit the vector loops stop and leave locating the lane to the scalar loop that finishes the
+// range, which keeps the masks in registers.
+template <size_t Width, typename T>
+[[gnu::always_inline]] inline size_t FirstUnequalImpl(const T* lhs, const T* rhs, size_t count) noexcept {
+  using L = Lanes<Width, T>;
+  size_t i = 0;
+  for (; i + L::kCount <= count; i += L::kCount) {
+    const auto mask = L::Load(lhs + i) != L::Load(rhs + i);
+    if (L::Any(mask)) {
+      break;
+    }
+  }
+  for (; i < count; ++i) {
+    if (!(lhs[i] == rhs[i])) {
+      return i;
+    }
+  }
+  return count;
+}
+
+template <size_t Width, typename T>
+[[gnu::always_inline]] inline size_t FirstOrderedImpl(const T* lhs, const T* rhs, size_t count) noexcept {
+  using L = Lanes<Width, T>;
+  size_t i = 0;
+  for (; i + L::kCount <= count; i += L::kCount) {
+    const auto left = L::Load(lhs + i);
+    const auto right = L::Load(rhs + i);
+    // The two masks are never set in the same lane; GCC scalarizes `|` on masks in this context.
+    const auto mask = (left < right) + (right < left);
+    if (L::Any(mask)) {
+      break;
+    }
+  }
+  for (; i < count; ++i) {
+    if (lhs[i] < rhs[i] || rhs[i] < lhs[i]) {
+      return i;
+    }
+  }
+  return count;
+}
+
+template <size_t Width, typename T>
+[[gnu::always_inline]] inline size_t FindImpl(const T* data, size_t count, T value) noexcept {
+  using L = Lanes<Width, T>;
+  const auto needle = L::Broadcast(value);
+  size_t i = 0;
+  for (; i + L::kCount <= count; i += L::kCount) {
+    const auto mask = L::Load(data + i) == needle;
+    if (L::Any(mask)) {
+      break;
+    }
+  }
+  for (; i < count; ++i) {
+    if (data[i] == value) {
+      return i;
+    }
+  }
+  return count;
+}
+
+template <size_t Width, typename T>
+[[gnu::always_inline]] inline size_t FindLastImpl(const T* data, size_t count, T value) noexcept {
+  using L = Lanes<Width, T>;
+  const auto needle = L::Broadcast(value);
+  size_t i = count;
+  for (; i >= L::kCount; i -= L::kCount) {
+    if (L::Any(L::Load(data + i - L::kCount) == needle)) {
+      break;
+    }
+  }
+  for (; i > 0; --i) {
+    if (data[i - 1] == value) {
+      return i - 1;
+    }
+  }
+  return count;
+}
+
+template <size_t Width, typename T>
+[[gnu::always_inline]] inline size_t CountImpl(const T* data, size_t count, T value) noexcept {
+  using L = Lanes<Width, T>;
+  // Matches are all-ones lanes, so subtracting them counts per lane; flush before a lane wraps.
+  constexpr size_t kFlushEvery = sizeof(T) >= 4 ? size_t{0xFFFFFFFF} : (size_t{1} << (8 * sizeof(T))) - 1;
+  const auto needle = L::Broadcast(value);
+  typename L::Counters counters{};
+  size_t blocks = 0;
+  size_t result = 0;
+  size_t i = 0;
+  for (; i + L::kCount <= count; i += L::kCount) {
+    counters -= (typename L::Counters)(L::Load(data + i) == needle);  // NOLINT
+    if (++blocks == kFlushEvery) {
+      result += L::Sum(counters);
+      counters = typename L::Counters{};
+      blocks = 0;
+    }
+  }
+  result += L::Sum(counters);
+  for (; i < count; ++i) {
+    result += data[i] == value ? 1 : 0;
+  }
+  return result;
+}
+
+template <size_t Width, typename T>
+[[gnu::always_inline]] inline std::pair<T, T> MinMaxImpl(const T* data, size_t count) noexcept {
+  using L = Lanes<Width, T>;
+  T min = data[0];
+  T max = data[0];
+  size_t i = 0;
+  if (count >= L::kCount) {
+    auto min_vec = L::Load(data);
+    auto max_vec = min_vec;
+    for (i = L::kCount; i + L::kCount <= count; i += L::kCount) {
+      const auto vec = L::Load(data + i);
+      min_vec = vec < min_vec ? vec : min_vec;
+      max_vec = max_vec < vec ? vec : max_vec;
+    }
+    for (size_t lane = 0; lane < L::kCount; ++lane) {
+      min = min_vec[lane] < min ? min_vec[lane] : min;
+      max = max < max_vec[lane] ? max_vec[lane] : max;
+    }
+  }
+  for (; i < count; ++i) {
+    min = data[i] < min ? data[i] : min;
+    max = max < data[i] ? data[i] : max;
+  }
+  return {min, max};
+}
+
+// SSE2 on x86-64 and NEON on AArch64, both part of the baseline ISA.
+inline constexpr size_t kBaseWidth = 16;
+
+#define VECTOR_SIMD_DEFINE_KERNELS(Suffix, Width, Target)                                             \
+  template <typename T>                                                                            \
+  Target size_t FirstUnequal##Suffix(const T* lhs, const T* rhs, size_t count) noexcept {         \
+    return FirstUnequalImpl<Width>(lhs, rhs, count);                                               \
+  }                                                                                                \
+  template <typename T>                                                                            \
+  Target size_t FirstOrdered##Suffix(const T* lhs, const T* rhs, size_t count) noexcept {         \
+    return FirstOrderedImpl<Width>(lhs, rhs, count);                                               \
+  }                                                                                                \
+  template <typename T>                                                                            \
+  Target size_t Find##Suffix(const T* data, size_t count, T value) noexcept {                      \
+    return FindImpl<Width>(data, count, value);                                                    \
+  }                                                                                                \
+  template <typename T>                                                                            \
+  Target size_t FindLast##Suffix(const T* data, size_t count, T value) noexcept {                  \
+    return FindLastImpl<Width>(data, count, value);                                                \
+  }                                                                                                \
+  template <typename T>                                                                            \
+  Target size_t Count##Suffix(const T* data, size_t count, T value) noexcept {                     \
+    return CountImpl<Width>(data, count, value);                                                   \
+  }                                                                                                \
+  template <typename T>                                                                            \
+  Target std::pair<T, T> MinMax##Suffix(const T* data, size_t count) noexcept {                    \
+    return MinMaxImpl<Width>(data, count);                                                         \
+  }
+
+VECTOR_SIMD_DEFINE_KERNELS(Base, kBaseWidth, )
+
+#if defined(VECTOR_SIMD_X86)
+VECTOR_SIMD_DEFINE_KERNELS(Avx2, 32, __attribute__((target("avx2"))))
+VECTOR_SIMD_DEFINE_KERNELS(Avx512, 64, __attribute__((target("avx512f,avx512bw"))))
+
+enum class Isa { kBase, kAvx2, kAvx512 };
+
+[[nodiscard]] inline Isa DetectIsa() noexcept {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+    return Isa::kAvx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return Isa::kAvx2;
+  }
+  return Isa::kBase;
+}
+
+[[nodiscard]] inline Isa ActiveIsa() noexcept {
+  static const Isa isa = DetectIsa();
+  return isa;
+}
+
+#define VECTOR_SIMD_DISPATCH(Kernel, ...)        \
+  switch (detail::ActiveIsa()) {                 \
+    case detail::Isa::kAvx512:                   \
+      return detail::Kernel##Avx512(__VA_ARGS__); \
+    case detail::Isa::kAvx2:                     \
+      return detail::Kernel##Avx2(__VA_ARGS__);   \
+    default:                                     \
+      return detail::Kernel##Base(__VA_ARGS__);   \
+  }
+#else
+#define VECTOR_SIMD_DISPATCH(Kernel, ...) return detail::Kernel##Base(__VA_ARGS__);
+#endif
+
+#undef VECTOR_SIMD_DEFINE_KERNELS
+#pragma GCC diagnostic pop
+
+#else  // !VECTOR_SIMD_ENABLED
+
+template <typename T>
+size_t FirstUnequalBase(const T* lhs, const T* rhs, size_t count) noexcept {
+  return static_cast<size_t>(std::mismatch(lhs, lhs + count, rhs).first - lhs);
+}
+template <typename T>
+size_t FirstOrderedBase(const T* lhs, const T* rhs, size_t count) noexcept {
+  size_t i = 0;
+  while (i < count && !(lhs[i] < rhs[i] || rhs[i] < lhs[i])) {
+    ++i;
+  }
+  return i;
+}
+template <typename T>
+size_t FindBase(const T* data, size_t count, T value) noexcept {
+  return static_cast<size_t>(std::find(data, data + count, value) - data);
+}
+template <typename T>
+size_t FindLastBase(const T* data, size_t count, T value) noexcept {
+  for (size_t i = count; i > 0; --i) {
+    if (data[i - 1] == value) {
+      return i - 1;
+    }
+  }
+  return count;
+}
+template <typename T>
+size_t CountBase(const T* data, size_t count, T value) noexcept {
+  return static_cast<size_t>(std::count(data, data + count, value));
+}
+template <typename T>
+std::pair<T, T> MinMaxBase(const T* data, size_t count) noexcept {
+  const auto [min, max] = std::minmax_element(data, data + count);
+  return {*min, *max};
+}
+
+#define VECTOR_SIMD_DISPATCH(Kernel, ...) return detail::Kernel##Base(__VA_ARGS__);
+
+#endif  // VECTOR_SIMD_ENABLED
+
+}  // namespace detail
+
+// Index of the first position where the ranges differ by operator==, or count.
+template <typename T>
+[[nodiscard]] size_t FirstUnequal(const T* lhs, const T* rhs, size_t count) noexcept {
+  VECTOR_SIMD_DISPATCH(FirstUnequal, lhs, rhs, count)
+}
+
+// Index of the first position where one element is less than the other, or count.
+template <typename T>
+[[nodiscard]] size_t FirstOrdered(const T* lhs, const T* rhs, size_t count) noexcept {
+  if constexpr (std::is_integral_v<T>) {
+    return FirstUnequal(lhs, rhs, count);
+  } else {
+    VECTOR_SIMD_DISPATCH(FirstOrdered, lhs, rhs, count)
+  }
+}
+
+// Index of the first element equal to value, or count.
+template <typename T>
+[[nodiscard]] size_t Find(const T* data, size_t count, T value) noexcept {
+  VECTOR_SIMD_DISPATCH(Find, data, count, value)
+}
+
+// Index of the last element equal to value, or count.
+template <typename T>
+[[nodiscard]] size_t FindLast(const T* data, size_t count, T value) noexcept {
+  VECTOR_SIMD_DISPATCH(FindLast, data, count, value)
+}
+
+template <typename T>
+[[nodiscard]] size_t Count(const T* data, size_t count, T value) noexcept {
+  VECTOR_SIMD_DISPATCH(Count, data, count, value)
+}
+
+// Smallest and largest value of a non-empty range. Unspecified if the range holds NaNs.
+template <typename T>
+[[nodiscard]] std::pair<T, T> MinMax(const T* data, size_t count) noexcept {
+  VECTOR_SIMD_DISPATCH(MinMax, data, count)
+}
+
+#undef VECTOR_SIMD_DISPATCH
+
+template <typename T>
+[[nodiscard]] bool Equal(const T* lhs, const T* rhs, size_t count) noexcept {
+  if constexpr (std::is_integral_v<T>) {
+    return count == 0 || std::memcmp(lhs, rhs, count * sizeof(T)) == 0;
+  } else {
+    return FirstUnequal(lhs, rhs, count) == count;
+  }
+}
+
+template <typename T>
+[[nodiscard]] bool Less(const T* lhs, size_t lhs_count, const T* rhs, size_t rhs_count) noexcept {
+  const size_t count = std::min(lhs_count, rhs_count);
+  if constexpr (kBytewiseOrdered<T>) {
+    const int order = count == 0 ? 0 : std::memcmp(lhs, rhs, count * sizeof(T));
+    return order != 0 ? order < 0 : lhs_count < rhs_count;
+  } else {
+    const size_t idx = FirstOrdered(lhs, rhs, count);
+    return idx == count ? lhs_count < rhs_count : lhs[idx] < rhs[idx];
+  }
+}
+
+}  // namespace vector_simd
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_VECTOR_SIMD_H_
@@ -0,0 +1,118 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_VECTOR_SINK_H_
+#define OOP_ASSIGNMENTS_VECTOR_VECTOR_SINK_H_
+#include <algorithm>
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <utility>
+
+#include "vector.h"
+#include "vector_view.h"
+
+// Coroutine front end of a Vector that a consumer drains: a producer coroutine appends with
+// `co_await sink.Append(chunk)`, or fills spare capacity in place with
+// `auto window = co_await sink.AcquireWriteWindow(n)` followed by sink.Commit(written). Either
+// suspends while the vector holds more than high_water elements would allow, and the consumer,
+// after taking elements out of the vector, calls Drained() to resume it. A chunk larger than
+// high_water is let through once the vector is empty, so that producers always make progress.
+// For one producer at a time, on the consumer's thread: Drained() resumes the producer inline.
+// A suspended producer is never resumed if the sink is destroyed first.
+template <typename T, class Allocator = std::allocator<T>, class GrowthPolicy = DoublingGrowth>
+class VectorSink {
+ public:
+  using Target = Vector<T, Allocator, GrowthPolicy>;
+
+  class AppendAwaiter {
+   public:
+    [[nodiscard]] bool await_ready() const noexcept {  // NOLINT
+      return sink_->Fits(chunk_.Size());
+    }
+    void await_suspend(std::coroutine_handle<> producer) noexcept {  // NOLINT
+      sink_->Park(producer, chunk_.Size());
+    }
+    void await_resume() {  // NOLINT
+      sink_->target_->AppendRange(chunk_.begin(), chunk_.end());
+    }
+
+   private:
+    friend class VectorSink;
+    AppendAwaiter(VectorSink* sink, ConstVectorView<T> chunk) noexcept : sink_(sink), chunk_(chunk) {
+    }
+
+    VectorSink* sink_;
+    ConstVectorView<T> chunk_;
+  };
+
+  class WindowAwaiter {
+   public:
+    [[nodiscard]] bool await_ready() const noexcept {  // NOLINT
+      return sink_->Fits(min_count_);
+    }
+    void await_suspend(std::coroutine_handle<> producer) noexcept {  // NOLINT
+      sink_->Park(producer, min_count_);
+    }
+    [[nodiscard]] typename Target::WriteWindow await_resume() {  // NOLINT
+      return sink_->target_->AcquireWriteWindow(min_count_);
+    }
+
+   private:
+    friend class VectorSink;
+    WindowAwaiter(VectorSink* sink, size_t min_count) noexcept : sink_(sink), min_count_(min_count) {
+    }
+
+    VectorSink* sink_;
+    size_t min_count_;
+  };
+
+  VectorSink(Target& target, size_t high_water) noexcept : target_(&target), high_water_(high_water) {
+  }
+  VectorSink(const VectorSink&) = delete;
+  VectorSink& operator=(const VectorSink&) = delete;
+
+  // Copies chunk into the vector once there is room for it; chunk must outlive the co_await.
+  [[nodiscard]] AppendAwaiter Append(ConstVectorView<T> chunk) noexcept {
+    return AppendAwaiter(this, chunk);
+  }
+  // Resolves to the vector's spare capacity, at least min_count elements, once there is room.
+  [[nodiscard]] WindowAwaiter AcquireWriteWindow(size_t min_count) noexcept {
+    return WindowAwaiter(this, min_count);
+  }
+  void Commit(size_t count) {
+    target_->Commit(count);
+  }
+
+  // Resumes the suspended producer if what it waits to add fits now.
+  void Drained() {
+    if (producer_ && Fits(pending_count_)) {
+      std::exchange(producer_, {}).resume();
+    }
+  }
+
+  [[nodiscard]] bool HasWaitingProducer() const noexcept {
+    return static_cast<bool>(producer_);
+  }
+  [[nodiscard]] Target& Get() noexcept {
+    return *target_;
+  }
+  [[nodiscard]] size_t HighWater() const noexcept {
+    return high_water_;
+  }
+
+ private:
+  [[nodiscard]] bool Fits(size_t count) const noexcept {
+    return target_->Empty() || count <= high_water_ - std::min(high_water_, target_->Size());
+  }
+
+  void Park(std::coroutine_handle<> producer, size_t count) noexcept {
+    assert(!producer_ && "VectorSink takes one producer at a time");
+    producer_ = producer;
+    pending_count_ = count;
+  }
+
+  Target* target_;
+  size_t high_water_;
+  std::coroutine_handle<> producer_;
+  size_t pending_count_{0};
+};
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_VECTOR_SINK_H_
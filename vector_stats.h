@@ -0,0 +1,269 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_VECTOR_STATS_H_
+#define OOP_ASSIGNMENTS_VECTOR_VECTOR_STATS_H_
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#if defined(VECTOR_STATS)
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#endif
+
+// Opt-in memory statistics for Vector. Define VECTOR_STATS before including vector.h (in every
+// translation unit) and each Vector reports to the entry of its tag in a process-wide
+// registry: the innermost VECTOR_STATS_TAG scope active when it was constructed, or the one
+// set with SetStatsTag. Without VECTOR_STATS every hook is an empty inline function on an
+// empty member, and the registry stays empty.
+namespace vector_stats {
+
+inline constexpr const char* kUntagged = "untagged";
+
+struct Counters {
+  uint64_t allocations{0};
+  // Buffer replacements or resizes that kept existing elements.
+  uint64_t reallocations{0};
+  uint64_t bytes_moved{0};
+  uint64_t peak_capacity_bytes{0};
+  uint64_t destructions{0};
+  // Capacity minus size, summed over the destroyed vectors.
+  uint64_t wasted_bytes_at_destruction{0};
+  uint64_t growth_nanoseconds{0};
+  // Reallocations by the new capacity in bytes, bucket k counting [2^k, 2^(k+1)).
+  std::array<uint64_t, 64> growth_histogram{};
+};
+
+[[nodiscard]] constexpr size_t Log2(uint64_t value) noexcept {
+  size_t log = 0;
+  while (value > 1) {
+    value >>= 1;
+    ++log;
+  }
+  return log;
+}
+
+#if defined(VECTOR_STATS)
+
+class Entry {
+ public:
+  void OnAllocate(size_t capacity_bytes) noexcept {
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    UpdatePeak(capacity_bytes);
+  }
+  void OnReallocate(size_t moved_bytes, size_t capacity_bytes) noexcept {
+    reallocations_.fetch_add(1, std::memory_order_relaxed);
+    UpdatePeak(capacity_bytes);
+    bytes_moved_.fetch_add(moved_bytes, std::memory_order_relaxed);
+    growth_histogram_[Log2(capacity_bytes)].fetch_add(1, std::memory_order_relaxed);
+  }
+  void OnDestroy(size_t wasted_bytes) noexcept {
+    destructions_.fetch_add(1, std::memory_order_relaxed);
+    wasted_bytes_at_destruction_.fetch_add(wasted_bytes, std::memory_order_relaxed);
+  }
+  void OnGrowthTime(uint64_t nanoseconds) noexcept {
+    growth_nanoseconds_.fetch_add(nanoseconds, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] Counters Load() const noexcept {
+    Counters counters;
+    counters.allocations = allocations_.load(std::memory_order_relaxed);
+    counters.reallocations = reallocations_.load(std::memory_order_relaxed);
+    counters.bytes_moved = bytes_moved_.load(std::memory_order_relaxed);
+    counters.peak_capacity_bytes = peak_capacity_bytes_.load(std::memory_order_relaxed);
+    counters.destructions = destructions_.load(std::memory_order_relaxed);
+    counters.wasted_bytes_at_destruction = wasted_bytes_at_destruction_.load(std::memory_order_relaxed);
+    counters.growth_nanoseconds = growth_nanoseconds_.load(std::memory_order_relaxed);
+    for (size_t k = 0; k < counters.growth_histogram.size(); ++k) {
+      counters.growth_histogram[k] = growth_histogram_[k].load(std::memory_order_relaxed);
+    }
+    return counters;
+  }
+
+ private:
+  void UpdatePeak(uint64_t capacity_bytes) noexcept {
+    uint64_t peak = peak_capacity_bytes_.load(std::memory_order_relaxed);
+    while (peak < capacity_bytes &&
+           !peak_capacity_bytes_.compare_exchange_weak(peak, capacity_bytes, std::memory_order_relaxed)) {
+    }
+  }
+
+  std::atomic<uint64_t> allocations_{0};
+  std::atomic<uint64_t> reallocations_{0};
+  std::atomic<uint64_t> bytes_moved_{0};
+  std::atomic<uint64_t> peak_capacity_bytes_{0};
+  std::atomic<uint64_t> destructions_{0};
+  std::atomic<uint64_t> wasted_bytes_at_destruction_{0};
+  std::atomic<uint64_t> growth_nanoseconds_{0};
+  std::array<std::atomic<uint64_t>, 64> growth_histogram_{};
+};
+
+#endif  // VECTOR_STATS
+
+// Process-wide table of entries by tag. Entries are never removed, so vectors may keep
+// pointers to theirs.
+class Registry {
+ public:
+  [[nodiscard]] static Registry& Instance() {
+    static Registry registry;
+    return registry;
+  }
+
+  // Calls visit(tag, counters) for every tag, in tag order.
+  template <class Visitor>
+  void ForEach(Visitor&& visit) const {
+#if defined(VECTOR_STATS)
+    std::lock_guard lock(mutex_);
+    for (const auto& [tag, entry] : entries_) {
+      visit(std::string_view(tag), entry->Load());
+    }
+#else
+    static_cast<void>(visit);
+#endif
+  }
+
+  // One line per tag, then the non-empty buckets of its growth histogram.
+  void Dump(std::ostream& out) const {
+    ForEach([&](auto tag, const Counters& counters) {
+      out << tag << ": allocations=" << counters.allocations << " reallocations=" << counters.reallocations
+          << " bytes_moved=" << counters.bytes_moved << " peak_capacity_bytes=" << counters.peak_capacity_bytes
+          << " destructions=" << counters.destructions
+          << " wasted_bytes_at_destruction=" << counters.wasted_bytes_at_destruction
+          << " growth_ns=" << counters.growth_nanoseconds << '\n';
+      for (size_t k = 0; k < counters.growth_histogram.size(); ++k) {
+        if (counters.growth_histogram[k] != 0) {
+          out << "  [" << (uint64_t{1} << k) << ", ";
+          if (k + 1 < counters.growth_histogram.size()) {
+            out << (uint64_t{1} << (k + 1));
+          } else {
+            out << "inf";
+          }
+          out << ") bytes: " << counters.growth_histogram[k] << '\n';
+        }
+      }
+    });
+  }
+
+#if defined(VECTOR_STATS)
+  // Falls back to a shared entry if the tag cannot be inserted, so that it never throws.
+  [[nodiscard]] Entry& Get(std::string_view tag) noexcept {
+    std::lock_guard lock(mutex_);
+    try {
+      auto found = entries_.find(tag);
+      if (found == entries_.end()) {
+        found = entries_.emplace(std::string(tag), std::make_unique<Entry>()).first;
+      }
+      return *found->second;
+    } catch (...) {
+      static Entry fallback;
+      return fallback;
+    }
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<std::string, std::unique_ptr<Entry>, std::less<>> entries_;
+#endif
+};
+
+#if defined(VECTOR_STATS)
+
+namespace detail {
+
+inline thread_local const char* current_tag = kUntagged;
+
+}  // namespace detail
+
+// Tags the vectors constructed on this thread while it is alive; tag must outlive them.
+class ScopedTag {
+ public:
+  explicit ScopedTag(const char* tag) noexcept : previous_(detail::current_tag) {
+    detail::current_tag = tag;
+  }
+  ScopedTag(const ScopedTag&) = delete;
+  ScopedTag& operator=(const ScopedTag&) = delete;
+  ~ScopedTag() {
+    detail::current_tag = previous_;
+  }
+
+ private:
+  const char* previous_;
+};
+
+// Measures the growth step it lives through.
+class GrowthTimer {
+ public:
+  explicit GrowthTimer(Entry* entry) noexcept : entry_(entry), start_(std::chrono::steady_clock::now()) {
+  }
+  GrowthTimer(const GrowthTimer&) = delete;
+  GrowthTimer& operator=(const GrowthTimer&) = delete;
+  ~GrowthTimer() {
+    const auto elapsed = std::chrono::steady_clock::now() - start_;
+    entry_->OnGrowthTime(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+  }
+
+ private:
+  Entry* entry_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+// What a Vector holds: the entry it reports to.
+class Handle {
+ public:
+  Handle() noexcept : entry_(&Registry::Instance().Get(detail::current_tag)) {
+  }
+
+  void SetTag(const char* tag) noexcept {
+    entry_ = &Registry::Instance().Get(tag);
+  }
+  void OnAllocate(size_t capacity_bytes) const noexcept {
+    entry_->OnAllocate(capacity_bytes);
+  }
+  void OnReallocate(size_t moved_bytes, size_t capacity_bytes) const noexcept {
+    entry_->OnReallocate(moved_bytes, capacity_bytes);
+  }
+  void OnDestroy(size_t wasted_bytes) const noexcept {
+    entry_->OnDestroy(wasted_bytes);
+  }
+  [[nodiscard]] GrowthTimer TimeGrowth() const noexcept {
+    return GrowthTimer(entry_);
+  }
+
+ private:
+  Entry* entry_;
+};
+
+#define VECTOR_STATS_CONCAT_IMPL(a, b) a##b
+#define VECTOR_STATS_CONCAT(a, b) VECTOR_STATS_CONCAT_IMPL(a, b)
+#define VECTOR_STATS_TAG(tag) const ::vector_stats::ScopedTag VECTOR_STATS_CONCAT(vector_stats_tag_, __LINE__)(tag)
+
+#else
+
+struct GrowthTimer {};
+
+struct Handle {
+  constexpr void SetTag(const char* /*tag*/) const noexcept {
+  }
+  constexpr void OnAllocate(size_t /*capacity_bytes*/) const noexcept {
+  }
+  constexpr void OnReallocate(size_t /*moved_bytes*/, size_t /*capacity_bytes*/) const noexcept {
+  }
+  constexpr void OnDestroy(size_t /*wasted_bytes*/) const noexcept {
+  }
+  [[nodiscard]] constexpr GrowthTimer TimeGrowth() const noexcept {
+    return {};
+  }
+};
+
+#define VECTOR_STATS_TAG(tag) static_cast<void>(0)
+
+#endif  // VECTOR_STATS
+
+}  // namespace vector_stats
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_VECTOR_STATS_H_
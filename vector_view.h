@@ -0,0 +1,277 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_VECTOR_VIEW_H_
+#define OOP_ASSIGNMENTS_VECTOR_VECTOR_VIEW_H_
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include "vector.h"
+
+template <typename T>
+class StridedVectorView;
+
+// Non-owning view of contiguous elements, e.g. a slice of a Vector. It is cheap to copy and
+// shallow-const like std::span: VectorView<const T> (ConstVectorView<T>) is the read-only one.
+template <typename T>
+class VectorView {
+ public:
+  using ValueType = std::remove_cv_t<T>;
+  using Pointer = T*;
+  using Reference = T&;
+  using SizeType = size_t;
+  using Iterator = Pointer;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+
+  static constexpr size_t kNpos = static_cast<size_t>(-1);
+
+  VectorView() noexcept = default;
+  VectorView(Pointer data, size_t size) noexcept : data_(data), size_(size) {
+  }
+  template <class Alloc, class Growth>
+  VectorView(Vector<ValueType, Alloc, Growth>& vector) noexcept  // NOLINT
+      : data_(vector.Data()), size_(vector.Size()) {
+  }
+  template <class Alloc, class Growth, class U = T, class = std::enable_if_t<std::is_const_v<U>>>
+  VectorView(const Vector<ValueType, Alloc, Growth>& vector) noexcept  // NOLINT
+      : data_(vector.Data()), size_(vector.Size()) {
+  }
+  template <typename U, class = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+  VectorView(const VectorView<U>& other) noexcept  // NOLINT
+      : data_(other.Data()), size_(other.Size()) {
+  }
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return size_;
+  }
+  [[nodiscard]] bool Empty() const noexcept {
+    return size_ == 0;
+  }
+  [[nodiscard]] Pointer Data() const noexcept {
+    return data_;
+  }
+  [[nodiscard]] Reference Front() const noexcept {
+    return data_[0];
+  }
+  [[nodiscard]] Reference Back() const noexcept {
+    return data_[size_ - 1];
+  }
+  [[nodiscard]] Reference At(size_t idx) const {
+    if (idx >= size_) {
+      throw std::out_of_range("");
+    }
+    return data_[idx];
+  }
+  [[nodiscard]] Reference operator[](size_t idx) const noexcept {
+    return data_[idx];
+  }
+
+  // Elements [offset, offset + count), clamped to the end of the view.
+  [[nodiscard]] VectorView Subview(size_t offset, size_t count = kNpos) const {
+    if (offset > size_) {
+      throw std::out_of_range("");
+    }
+    return {data_ + offset, std::min(count, size_ - offset)};
+  }
+  [[nodiscard]] VectorView First(size_t count) const {
+    if (count > size_) {
+      throw std::out_of_range("");
+    }
+    return {data_, count};
+  }
+  [[nodiscard]] VectorView Last(size_t count) const {
+    if (count > size_) {
+      throw std::out_of_range("");
+    }
+    return {data_ + size_ - count, count};
+  }
+  // Every stride-th element starting at offset; Strided(width, j) is column j of a row-major matrix.
+  [[nodiscard]] StridedVectorView<T> Strided(size_t stride, size_t offset = 0) const {
+    if (stride == 0) {
+      throw std::invalid_argument("");
+    }
+    if (offset > size_) {
+      throw std::out_of_range("");
+    }
+    return {data_ + offset, offset == size_ ? 0 : (size_ - offset - 1) / stride + 1, stride};
+  }
+
+  [[nodiscard]] Iterator begin() const noexcept {  // NOLINT
+    return data_;
+  }
+  [[nodiscard]] Iterator end() const noexcept {  // NOLINT
+    return data_ + size_;
+  }
+  [[nodiscard]] ReverseIterator rbegin() const noexcept {  // NOLINT
+    return ReverseIterator(end());
+  }
+  [[nodiscard]] ReverseIterator rend() const noexcept {  // NOLINT
+    return ReverseIterator(begin());
+  }
+
+ private:
+  Pointer data_{nullptr};
+  size_t size_{0};
+};
+
+template <typename T, class Alloc, class Growth>
+VectorView(Vector<T, Alloc, Growth>&) -> VectorView<T>;
+
+template <typename T, class Alloc, class Growth>
+VectorView(const Vector<T, Alloc, Growth>&) -> VectorView<const T>;
+
+template <typename T>
+using ConstVectorView = VectorView<const T>;
+
+// Non-owning view of elements lying a fixed number of elements apart.
+template <typename T>
+class StridedVectorView {
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;  // NOLINT
+    using value_type = std::remove_cv_t<T>;  // NOLINT
+    using difference_type = ptrdiff_t;  // NOLINT
+    using pointer = T*;  // NOLINT
+    using reference = T&;  // NOLINT
+
+    Iterator() noexcept = default;
+    Iterator(T* data, ptrdiff_t idx, size_t stride) noexcept
+        : data_(data), idx_(idx), stride_(static_cast<ptrdiff_t>(stride)) {
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {
+      return data_[idx_ * stride_];
+    }
+    [[nodiscard]] pointer operator->() const noexcept {
+      return data_ + idx_ * stride_;
+    }
+    [[nodiscard]] reference operator[](difference_type n) const noexcept {
+      return data_[(idx_ + n) * stride_];
+    }
+
+    Iterator& operator++() noexcept {
+      ++idx_;
+      return *this;
+    }
+    Iterator operator++(int) noexcept {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+    Iterator& operator--() noexcept {
+      --idx_;
+      return *this;
+    }
+    Iterator operator--(int) noexcept {
+      auto copy = *this;
+      --*this;
+      return copy;
+    }
+    Iterator& operator+=(difference_type n) noexcept {
+      idx_ += n;
+      return *this;
+    }
+    Iterator& operator-=(difference_type n) noexcept {
+      idx_ -= n;
+      return *this;
+    }
+    [[nodiscard]] friend Iterator operator+(Iterator it, difference_type n) noexcept {
+      return it += n;
+    }
+    [[nodiscard]] friend Iterator operator+(difference_type n, Iterator it) noexcept {
+      return it += n;
+    }
+    [[nodiscard]] friend Iterator operator-(Iterator it, difference_type n) noexcept {
+      return it -= n;
+    }
+    [[nodiscard]] friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept {
+      return lhs.idx_ - rhs.idx_;
+    }
+
+    [[nodiscard]] friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+      return lhs.idx_ == rhs.idx_;
+    }
+    [[nodiscard]] friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept {
+      return lhs.idx_ != rhs.idx_;
+    }
+    [[nodiscard]] friend bool operator<(const Iterator& lhs, const Iterator& rhs) noexcept {
+      return lhs.idx_ < rhs.idx_;
+    }
+    [[nodiscard]] friend bool operator>(const Iterator& lhs, const Iterator& rhs) noexcept {
+      return rhs < lhs;
+    }
+    [[nodiscard]] friend bool operator<=(const Iterator& lhs, const Iterator& rhs) noexcept {
+      return !(rhs < lhs);
+    }
+    [[nodiscard]] friend bool operator>=(const Iterator& lhs, const Iterator& rhs) noexcept {
+      return !(lhs < rhs);
+    }
+
+   private:
+    // Positions are kept as indices, so the end iterator never forms a pointer past the data.
+    T* data_{nullptr};
+    ptrdiff_t idx_{0};
+    ptrdiff_t stride_{1};
+  };
+
+  using ValueType = std::remove_cv_t<T>;
+  using Reference = T&;
+  using SizeType = size_t;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+
+  StridedVectorView() noexcept = default;
+  StridedVectorView(T* data, size_t size, size_t stride) noexcept : data_(data), size_(size), stride_(stride) {
+  }
+  template <typename U, class = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+  StridedVectorView(const StridedVectorView<U>& other) noexcept  // NOLINT
+      : data_(other.Data()), size_(other.Size()), stride_(other.Stride()) {
+  }
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return size_;
+  }
+  [[nodiscard]] bool Empty() const noexcept {
+    return size_ == 0;
+  }
+  [[nodiscard]] size_t Stride() const noexcept {
+    return stride_;
+  }
+  [[nodiscard]] T* Data() const noexcept {
+    return data_;
+  }
+  [[nodiscard]] Reference Front() const noexcept {
+    return data_[0];
+  }
+  [[nodiscard]] Reference Back() const noexcept {
+    return data_[(size_ - 1) * stride_];
+  }
+  [[nodiscard]] Reference At(size_t idx) const {
+    if (idx >= size_) {
+      throw std::out_of_range("");
+    }
+    return data_[idx * stride_];
+  }
+  [[nodiscard]] Reference operator[](size_t idx) const noexcept {
+    return data_[idx * stride_];
+  }
+
+  [[nodiscard]] Iterator begin() const noexcept {  // NOLINT
+    return Iterator(data_, 0, stride_);
+  }
+  [[nodiscard]] Iterator end() const noexcept {  // NOLINT
+    return Iterator(data_, static_cast<ptrdiff_t>(size_), stride_);
+  }
+  [[nodiscard]] ReverseIterator rbegin() const noexcept {  // NOLINT
+    return ReverseIterator(end());
+  }
+  [[nodiscard]] ReverseIterator rend() const noexcept {  // NOLINT
+    return ReverseIterator(begin());
+  }
+
+ private:
+  T* data_{nullptr};
+  size_t size_{0};
+  size_t stride_{1};
+};
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_VECTOR_VIEW_H_